@@ -20,6 +20,8 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include "libmscore/note.h"
 #include "libmscore/harmony.h"
 #include "libmscore/sig.h"
@@ -286,6 +288,89 @@ void EventList::insert(const Event& e)
     append(e);
 }
 
+//---------------------------------------------------------
+//   EventMap::sort
+//---------------------------------------------------------
+
+void EventMap::sort() const
+{
+    if (m_sortedSize == m_events.size()) {
+        return;
+    }
+
+    auto tickLess = [](const value_type& e1, const value_type& e2) {
+        return e1.first < e2.first;
+    };
+
+    // the appended events are mostly in order already
+    const auto appended = m_events.begin() + m_sortedSize;
+    if (!std::is_sorted(appended, m_events.end(), tickLess)) {
+        std::stable_sort(appended, m_events.end(), tickLess);
+    }
+
+    // stable: the appended events go after the events with equal ticks
+    if (m_sortedSize > 0 && tickLess(*appended, *(appended - 1))) {
+        std::inplace_merge(m_events.begin(), appended, m_events.end(), tickLess);
+    }
+
+    m_sortedSize = m_events.size();
+}
+
+//---------------------------------------------------------
+//   EventMap::erase
+//---------------------------------------------------------
+
+EventMap::iterator EventMap::erase(const_iterator pos)
+{
+    sort();
+    iterator it = m_events.erase(pos);
+    m_sortedSize = m_events.size();
+    return it;
+}
+
+EventMap::iterator EventMap::erase(const_iterator first, const_iterator last)
+{
+    sort();
+    iterator it = m_events.erase(first, last);
+    m_sortedSize = m_events.size();
+    return it;
+}
+
+//---------------------------------------------------------
+//   EventMap::clear
+//---------------------------------------------------------
+
+void EventMap::clear()
+{
+    m_events.clear();
+    m_sortedSize = 0;
+}
+
+//---------------------------------------------------------
+//   EventMap::lower_bound
+//   EventMap::upper_bound
+//   EventMap::equal_range
+//---------------------------------------------------------
+
+EventMap::const_iterator EventMap::lower_bound(int tick) const
+{
+    return std::lower_bound(begin(), end(), tick, [](const value_type& e, int t) {
+        return e.first < t;
+    });
+}
+
+EventMap::const_iterator EventMap::upper_bound(int tick) const
+{
+    return std::upper_bound(begin(), end(), tick, [](int t, const value_type& e) {
+        return t < e.first;
+    });
+}
+
+std::pair<EventMap::const_iterator, EventMap::const_iterator> EventMap::equal_range(int tick) const
+{
+    return { lower_bound(tick), upper_bound(tick) };
+}
+
 //---------------------------------------------------------
 //   class EventMap::fixupMIDI
 //---------------------------------------------------------
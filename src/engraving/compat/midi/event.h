@@ -24,6 +24,7 @@
 #define __EVENT_H__
 
 #include <map>
+#include <vector>
 #include <QList>
 
 namespace Ms {
@@ -311,8 +312,9 @@ class NPlayEvent : public PlayEvent
 {
     const Note* _note{ nullptr };
     const Harmony* _harmony{ nullptr };
-    int _origin = -1;
-    int _discard = 0;
+    // staff indices, 16 bits keep the event in 32 bytes on 64-bit platforms
+    int16_t _origin = -1;
+    int16_t _discard = 0;
     bool _portamento = false;
 
 public:
@@ -330,8 +332,8 @@ public:
     void setHarmony(const Harmony* v) { _harmony = v; }
 
     int getOriginatingStaff() const { return _origin; }
-    void setOriginatingStaff(int i) { _origin = i; }
-    void setDiscard(int d) { _discard = d; }
+    void setOriginatingStaff(int i) { _origin = static_cast<int16_t>(i); }
+    void setDiscard(int d) { _discard = static_cast<int16_t>(d); }
     int discard() const { return _discard; }
     bool isMuted() const;
     void setPortamento(bool p) { _portamento = p; }
@@ -399,7 +401,6 @@ public:
 
 //---------------------------------------------------------
 //   EventList
-//   EventMap
 //---------------------------------------------------------
 
 class EventList : public QList<Event>
@@ -409,10 +410,53 @@ public:
     void insertNote(int channel, Note*);
 };
 
-class EventMap : public std::multimap<int, NPlayEvent>
+//---------------------------------------------------------
+//   EventMap
+//    events ordered by tick, events with equal ticks are kept
+//    in the order of their insertion (like std::multimap).
+//    Events are appended to a flat vector and sorted lazily
+//    on the first access, so rendering doesn't allocate
+//    a tree node per event.
+//---------------------------------------------------------
+
+class EventMap
 {
-    int _highestChannel = 15;
 public:
+    using value_type = std::pair<int, NPlayEvent>;
+    using container_type = std::vector<value_type>;
+    using iterator = container_type::iterator;
+    using const_iterator = container_type::const_iterator;
+    using size_type = container_type::size_type;
+
+    void insert(const value_type& event) { m_events.push_back(event); }
+    void insert(value_type&& event) { m_events.push_back(std::move(event)); }
+
+    template<class InputIt>
+    void insert(InputIt first, InputIt last) { m_events.insert(m_events.end(), first, last); }
+
+    iterator erase(const_iterator pos);
+    iterator erase(const_iterator first, const_iterator last);
+    void clear();
+
+    size_type size() const { return m_events.size(); }
+    bool empty() const { return m_events.empty(); }
+
+    iterator begin() { sort(); return m_events.begin(); }
+    iterator end() { sort(); return m_events.end(); }
+    const_iterator begin() const { sort(); return m_events.cbegin(); }
+    const_iterator end() const { sort(); return m_events.cend(); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    const_iterator lower_bound(int tick) const;
+    const_iterator upper_bound(int tick) const;
+    std::pair<const_iterator, const_iterator> equal_range(int tick) const;
+
+    //! NOTE Sorts the events appended since the last access.
+    //! Not thread-safe while there are unsorted events,
+    //! sort the map before sharing it between threads.
+    void sort() const;
+
     void fixupMIDI();
     void registerChannel(int c)
     {
@@ -420,6 +464,13 @@ public:
             _highestChannel = c;
         }
     }
+
+    int highestChannel() const { return _highestChannel; }
+
+private:
+    mutable container_type m_events;
+    mutable size_type m_sortedSize = 0;
+    int _highestChannel = 15;
 };
 
 typedef EventList::iterator iEvent;
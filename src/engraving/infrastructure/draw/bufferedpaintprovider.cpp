@@ -137,6 +137,11 @@ void BufferedPaintProvider::setCompositionMode(CompositionMode mode)
     editableState().compositionMode = mode;
 }
 
+void BufferedPaintProvider::setSymbolsCacheEnabled(bool)
+{
+    //! NOTE Symbols are buffered as they are, nothing is rasterized here
+}
+
 void BufferedPaintProvider::setFont(const Font& f)
 {
     editableState().font = f;
@@ -48,6 +48,7 @@ public:
 
     void setAntialiasing(bool arg) override;
     void setCompositionMode(CompositionMode mode) override;
+    void setSymbolsCacheEnabled(bool arg) override;
 
     void setFont(const Font& font) override;
     const Font& font() const override;
@@ -50,6 +50,7 @@ public:
 
     virtual void setAntialiasing(bool arg) = 0;
     virtual void setCompositionMode(CompositionMode mode) = 0;
+    virtual void setSymbolsCacheEnabled(bool arg) = 0;
 
     virtual void setFont(const Font& font) = 0;
     virtual const Font& font() const = 0;
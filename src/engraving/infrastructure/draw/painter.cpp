@@ -138,6 +138,14 @@ void Painter::setAntialiasing(bool arg)
     }
 }
 
+void Painter::setSymbolsCacheEnabled(bool arg)
+{
+    m_provider->setSymbolsCacheEnabled(arg);
+    if (extended) {
+        extended->setSymbolsCacheEnabled(arg);
+    }
+}
+
 void Painter::setCompositionMode(CompositionMode mode)
 {
     m_provider->setCompositionMode(mode);
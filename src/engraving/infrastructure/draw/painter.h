@@ -68,6 +68,10 @@ public:
     void setAntialiasing(bool arg);
     void setCompositionMode(CompositionMode mode);
 
+    //! NOTE Allows the provider to draw symbols from a cache of rasterized glyphs.
+    //! Only for on-screen painting, the result is not exact enough for export or printing.
+    void setSymbolsCacheEnabled(bool arg);
+
     void setFont(const Font& font);
     const Font& font() const;
 
@@ -94,6 +94,11 @@ void EngravingConfiguration::setPartStyleFilePath(const QString& path)
     settings()->setSharedValue(PART_STYLE_FILE_PATH, Val(path.toStdString()));
 }
 
+QString EngravingConfiguration::scoreFontsCachePath() const
+{
+    return globalConfiguration()->userAppDataPath().toQString() + "/scorefonts";
+}
+
 std::string EngravingConfiguration::iconsFontFamily() const
 {
     return uiConfiguration()->iconsFontFamily();
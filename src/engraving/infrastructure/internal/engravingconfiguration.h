@@ -26,11 +26,13 @@
 #include "modularity/ioc.h"
 #include "async/asyncable.h"
 #include "ui/iuiconfiguration.h"
+#include "iglobalconfiguration.h"
 
 namespace mu::engraving {
 class EngravingConfiguration : public IEngravingConfiguration, public async::Asyncable
 {
     INJECT(engraving, mu::ui::IUiConfiguration, uiConfiguration)
+    INJECT(engraving, mu::framework::IGlobalConfiguration, globalConfiguration)
 
 public:
     EngravingConfiguration() = default;
@@ -43,6 +45,8 @@ public:
     QString partStyleFilePath() const override;
     void setPartStyleFilePath(const QString& path) override;
 
+    QString scoreFontsCachePath() const override;
+
     std::string iconsFontFamily() const override;
 
     draw::Color defaultColor() const override;
@@ -21,8 +21,10 @@
  */
 #include "fontengineft.h"
 
+#include <algorithm>
+#include <vector>
+
 #include <QFile>
-#include <QHash>
 
 #include "ft2build.h"
 #include FT_FREETYPE_H
@@ -49,15 +51,19 @@ static bool _init_ft()
 
 struct mu::draw::FTGlyphMetrics
 {
+    uint ucs4 = 0;
     FT_BBox bb;
     double linearHoriAdvance = 0.0;
 };
 
+//! NOTE The metrics of all glyphs of the font are read on load and never change afterwards,
+//! so they can be queried concurrently (e.g. from parallel layout) without any locking.
+//! The face is only used while loading.
 struct mu::draw::FTData
 {
     QByteArray fontData;
     FT_Face face = nullptr;
-    QHash<uint, FTGlyphMetrics> metrics;
+    std::vector<FTGlyphMetrics> metrics; // sorted by ucs4
 };
 
 FontEngineFT::FontEngineFT()
@@ -67,6 +73,10 @@ FontEngineFT::FontEngineFT()
 
 FontEngineFT::~FontEngineFT()
 {
+    if (m_data->face) {
+        FT_Done_Face(m_data->face);
+    }
+
     delete m_data;
 }
 
@@ -94,12 +104,42 @@ bool FontEngineFT::load(const QString& path)
     qreal pixelSize = 200.0;
     FT_Set_Pixel_Sizes(m_data->face, 0, int(pixelSize + .5));
 
+    loadGlyphMetrics();
+
     return true;
 }
 
+void FontEngineFT::loadGlyphMetrics()
+{
+    m_data->metrics.clear();
+    m_data->metrics.reserve(m_data->face->num_glyphs);
+
+    FT_UInt index = 0;
+    FT_ULong ucs4 = FT_Get_First_Char(m_data->face, &index);
+    while (index != 0) {
+        if (FT_Load_Glyph(m_data->face, index, FT_LOAD_DEFAULT) == 0) {
+            FT_BBox bb;
+            if (FT_Outline_Get_BBox(&m_data->face->glyph->outline, &bb) == 0) {
+                FTGlyphMetrics gm;
+                gm.ucs4 = static_cast<uint>(ucs4);
+                gm.bb = bb;
+                gm.linearHoriAdvance = m_data->face->glyph->linearHoriAdvance;
+                m_data->metrics.push_back(gm);
+            }
+        }
+
+        ucs4 = FT_Get_Next_Char(m_data->face, ucs4, &index);
+    }
+
+    //! NOTE The charmap is usually iterated in order, but it is not guaranteed
+    std::sort(m_data->metrics.begin(), m_data->metrics.end(), [](const FTGlyphMetrics& m1, const FTGlyphMetrics& m2) {
+        return m1.ucs4 < m2.ucs4;
+    });
+}
+
 QRectF FontEngineFT::bbox(uint ucs4, qreal dpi_f) const
 {
-    FTGlyphMetrics* gm = glyphMetrics(ucs4);
+    const FTGlyphMetrics* gm = glyphMetrics(ucs4);
     if (!gm) {
         return QRectF();
     }
@@ -114,7 +154,7 @@ QRectF FontEngineFT::bbox(uint ucs4, qreal dpi_f) const
 
 qreal FontEngineFT::advance(uint ucs4, qreal dpi_f) const
 {
-    FTGlyphMetrics* gm = glyphMetrics(ucs4);
+    const FTGlyphMetrics* gm = glyphMetrics(ucs4);
     if (!gm) {
         return 0.0;
     }
@@ -123,29 +163,15 @@ qreal FontEngineFT::advance(uint ucs4, qreal dpi_f) const
     return gm->linearHoriAdvance * dpi_f / 655360.0;
 }
 
-FTGlyphMetrics* FontEngineFT::glyphMetrics(uint ucs4) const
+const FTGlyphMetrics* FontEngineFT::glyphMetrics(uint ucs4) const
 {
-    if (m_data->metrics.contains(ucs4)) {
-        return &m_data->metrics[ucs4];
-    }
-
-    FT_UInt index = FT_Get_Char_Index(m_data->face, ucs4);
-    if (index == 0) {
-        return nullptr;
-    }
+    auto it = std::lower_bound(m_data->metrics.cbegin(), m_data->metrics.cend(), ucs4, [](const FTGlyphMetrics& gm, uint code) {
+        return gm.ucs4 < code;
+    });
 
-    if (FT_Load_Glyph(m_data->face, index, FT_LOAD_DEFAULT) != 0) {
+    if (it == m_data->metrics.cend() || it->ucs4 != ucs4) {
         return nullptr;
     }
 
-    FT_BBox bb;
-    if (FT_Outline_Get_BBox(&m_data->face->glyph->outline, &bb) != 0) {
-        return nullptr;
-    }
-
-    FTGlyphMetrics& gm = m_data->metrics[ucs4];
-    gm.bb = bb;
-    gm.linearHoriAdvance = m_data->face->glyph->linearHoriAdvance;
-
-    return &gm;
+    return &(*it);
 }
@@ -41,7 +41,8 @@ public:
 
 private:
 
-    FTGlyphMetrics* glyphMetrics(uint ucs4) const;
+    void loadGlyphMetrics();
+    const FTGlyphMetrics* glyphMetrics(uint ucs4) const;
 
     FTData* m_data = nullptr;
 };
@@ -154,6 +154,18 @@ FontEngineFT* QFontProvider::symEngine(const Font& f) const
         return nullptr;
     }
 
+    //! NOTE The engines are read-only once loaded and are created only once per font,
+    //! so the lookups during the parallel layout take the lock shared and don't contend
+    {
+        std::shared_lock<std::shared_mutex> lock(m_symEnginesMutex);
+        FontEngineFT* engine = m_symEngines.value(path, nullptr);
+        if (engine) {
+            return engine;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_symEnginesMutex);
+
     FontEngineFT* engine = m_symEngines.value(path, nullptr);
     if (!engine) {
         engine = new FontEngineFT();
@@ -22,6 +22,8 @@
 #ifndef MU_DRAW_QFONTPROVIDER_H
 #define MU_DRAW_QFONTPROVIDER_H
 
+#include <shared_mutex>
+
 #include <QHash>
 #include "infrastructure/draw/ifontprovider.h"
 
@@ -63,6 +65,7 @@ private:
 
     QHash<QString /*family*/, QString /*path*/> m_paths;
     mutable QHash<QString /*path*/, FontEngineFT*> m_symEngines;
+    mutable std::shared_mutex m_symEnginesMutex;
 };
 }
 
@@ -21,8 +21,16 @@
  */
 #include "qpainterprovider.h"
 
+#include <cmath>
+#include <list>
+#include <memory>
+
+#include <QCache>
+#include <QFontMetricsF>
+#include <QPaintEngine>
 #include <QPainter>
 #include <QRawFont>
+#include <QThreadStorage>
 #include <QTextLayout>
 #include <QTextLine>
 #include <QGlyphRun>
@@ -38,6 +46,82 @@
 
 using namespace mu::draw;
 
+//! NOTE Cache of rasterized symbols for on-screen painting.
+//! A symbol is rendered once per font, colour, scale and sub-pixel position,
+//! and then just blitted, which is much cheaper than rasterizing its outline every time.
+//! Images of one scale are useless at any other one, so the cache is split into buckets per scale,
+//! and only the few most recently used scales are kept: each zoom step drops the stalest bucket
+//! instead of filling the cache up with images that will never be drawn again.
+namespace {
+static constexpr int SYMBOLS_CACHE_MAX_COST = 32 * 1024; // KB
+static constexpr size_t SYMBOLS_CACHE_MAX_SCALES = 2; // e.g. the score and a thumbnail painted in the same thread
+static constexpr int SYMBOL_MAX_SIZE = 512; // px, larger symbols are drawn as outlines
+static constexpr int SYMBOL_MARGIN = 2; // px, for antialiasing
+static constexpr int SUBPIXEL_STEPS = 4;
+
+struct SymbolKey {
+    QString text;
+    QString font;
+    QRgb color = 0;
+    int phaseX = 0;
+    int phaseY = 0;
+
+    bool operator==(const SymbolKey& other) const
+    {
+        return text == other.text && font == other.font && color == other.color
+               && phaseX == other.phaseX && phaseY == other.phaseY;
+    }
+};
+
+inline uint qHash(const SymbolKey& key, uint seed = 0)
+{
+    return ::qHash(key.text, seed) ^ ::qHash(key.font, seed) ^ ::qHash(key.color, seed)
+           ^ ::qHash(key.phaseX * SUBPIXEL_STEPS + key.phaseY, seed);
+}
+
+struct SymbolImage {
+    QImage image;
+    QPoint topLeft; // relative to the symbol origin, in device pixels
+};
+
+using SymbolsBucket = QCache<SymbolKey, SymbolImage>;
+
+class SymbolsCache
+{
+public:
+    SymbolsBucket* bucket(qint64 scale)
+    {
+        for (auto it = m_buckets.begin(); it != m_buckets.end(); ++it) {
+            if (it->first == scale) {
+                m_buckets.splice(m_buckets.begin(), m_buckets, it);
+                return it->second.get();
+            }
+        }
+
+        if (m_buckets.size() >= SYMBOLS_CACHE_MAX_SCALES) {
+            m_buckets.pop_back();
+        }
+
+        m_buckets.emplace_front(scale, std::make_unique<SymbolsBucket>(SYMBOLS_CACHE_MAX_COST / SYMBOLS_CACHE_MAX_SCALES));
+        return m_buckets.front().second.get();
+    }
+
+private:
+    std::list<std::pair<qint64, std::unique_ptr<SymbolsBucket> > > m_buckets; // most recently used first
+};
+
+//! NOTE Painting may happen in several threads (e.g. thumbnails), each one gets its own cache
+static QThreadStorage<SymbolsCache*> s_symbolsCache;
+
+static SymbolsCache* symbolsCache()
+{
+    if (!s_symbolsCache.hasLocalData()) {
+        s_symbolsCache.setLocalData(new SymbolsCache());
+    }
+    return s_symbolsCache.localData();
+}
+}
+
 QPainterProvider::QPainterProvider(QPainter* painter, bool overship)
     : m_painter(painter), m_overship(overship), m_drawObjectsLogger(new DrawObjectsLogger()),
     m_font(Font::fromQFont(m_painter->font())),
@@ -119,6 +203,11 @@ void QPainterProvider::setCompositionMode(CompositionMode mode)
     m_painter->setCompositionMode(toQPainter(mode));
 }
 
+void QPainterProvider::setSymbolsCacheEnabled(bool arg)
+{
+    m_symbolsCacheEnabled = arg;
+}
+
 void QPainterProvider::setFont(const Font& font)
 {
     if (m_font != font) {
@@ -291,7 +380,99 @@ void QPainterProvider::drawSymbol(const PointF& point, uint ucs4Code)
         cache[ucs4Code] = QString::fromUcs4(&ucs4Code, 1);
     }
 
-    m_painter->drawText(QPointF(point.x(), point.y()), cache[ucs4Code]);
+    const QString& text = cache[ucs4Code];
+
+    if (m_symbolsCacheEnabled && drawCachedSymbol(point, text)) {
+        return;
+    }
+
+    m_painter->drawText(QPointF(point.x(), point.y()), text);
+}
+
+bool QPainterProvider::drawCachedSymbol(const PointF& point, const QString& text)
+{
+    //! NOTE Only for plain scaling on a raster device; rotated symbols,
+    //! vector devices (print, pdf, svg) and very large glyphs are drawn as outlines
+    QPaintEngine* engine = m_painter->paintEngine();
+    if (!engine || engine->type() != QPaintEngine::Raster || m_painter->viewTransformEnabled()) {
+        return false;
+    }
+
+    const QTransform worldTransform = m_painter->worldTransform();
+    if (worldTransform.type() > QTransform::TxScale || worldTransform.m11() <= 0.0
+        || !qFuzzyCompare(worldTransform.m11(), worldTransform.m22())) {
+        return false;
+    }
+
+    const QPaintDevice* device = m_painter->device();
+    const qreal dpr = device->devicePixelRatioF();
+    const qreal scale = worldTransform.m11() * dpr;
+
+    QPointF devicePos = worldTransform.map(QPointF(point.x(), point.y())) * dpr;
+    qreal x = std::floor(devicePos.x());
+    qreal y = std::floor(devicePos.y());
+    int phaseX = qRound((devicePos.x() - x) * SUBPIXEL_STEPS);
+    int phaseY = qRound((devicePos.y() - y) * SUBPIXEL_STEPS);
+    if (phaseX == SUBPIXEL_STEPS) {
+        x += 1.0;
+        phaseX = 0;
+    }
+    if (phaseY == SUBPIXEL_STEPS) {
+        y += 1.0;
+        phaseY = 0;
+    }
+
+    const QFont& font = m_painter->font();
+    const QColor color = m_painter->pen().color();
+
+    SymbolKey key { text, font.key(), color.rgba(), phaseX, phaseY };
+
+    SymbolsBucket* cache = symbolsCache()->bucket(qRound64(scale * 1000.0));
+    SymbolImage* symbol = cache->object(key);
+    if (!symbol) {
+        QRectF bounds = QFontMetricsF(font, device).boundingRect(text);
+        int left = static_cast<int>(std::floor(bounds.left() * scale)) - SYMBOL_MARGIN;
+        int top = static_cast<int>(std::floor(bounds.top() * scale)) - SYMBOL_MARGIN;
+        int right = static_cast<int>(std::ceil(bounds.right() * scale)) + SYMBOL_MARGIN;
+        int bottom = static_cast<int>(std::ceil(bounds.bottom() * scale)) + SYMBOL_MARGIN;
+
+        QSize size(right - left, bottom - top);
+        if (size.width() > SYMBOL_MAX_SIZE || size.height() > SYMBOL_MAX_SIZE || size.isEmpty()) {
+            return false;
+        }
+
+        symbol = new SymbolImage();
+        symbol->topLeft = QPoint(left, top);
+        symbol->image = QImage(size, QImage::Format_ARGB32_Premultiplied);
+        symbol->image.fill(Qt::transparent);
+
+        //! NOTE The font size depends on the resolution of the device
+        symbol->image.setDotsPerMeterX(qRound(device->logicalDpiX() / 0.0254));
+        symbol->image.setDotsPerMeterY(qRound(device->logicalDpiY() / 0.0254));
+
+        QPainter imagePainter(&symbol->image);
+        imagePainter.setRenderHints(m_painter->renderHints());
+        imagePainter.setFont(font);
+        imagePainter.setPen(color);
+        imagePainter.translate(-left + qreal(phaseX) / SUBPIXEL_STEPS, -top + qreal(phaseY) / SUBPIXEL_STEPS);
+        imagePainter.scale(scale, scale);
+        imagePainter.drawText(QPointF(0.0, 0.0), text);
+        imagePainter.end();
+
+        symbol->image.setDevicePixelRatio(dpr);
+
+        int cost = qMax(1, size.width() * size.height() * 4 / 1024);
+        if (!cache->insert(key, symbol, cost)) {
+            //! NOTE The symbol was deleted by the cache
+            return false;
+        }
+    }
+
+    m_painter->setWorldTransform(QTransform());
+    m_painter->drawImage(QPointF((x + symbol->topLeft.x()) / dpr, (y + symbol->topLeft.y()) / dpr), symbol->image);
+    m_painter->setWorldTransform(worldTransform);
+
+    return true;
 }
 
 void QPainterProvider::drawPixmap(const PointF& point, const Pixmap& pm)
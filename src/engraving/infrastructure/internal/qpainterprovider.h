@@ -50,6 +50,7 @@ public:
 
     void setAntialiasing(bool arg) override;
     void setCompositionMode(CompositionMode mode) override;
+    void setSymbolsCacheEnabled(bool arg) override;
 
     void setFont(const Font& font) override;
     const Font& font() const override;
@@ -90,7 +91,10 @@ protected:
     QPainter* m_painter = nullptr;
 
 private:
+    bool drawCachedSymbol(const PointF& point, const QString& text);
+
     bool m_overship = false;
+    bool m_symbolsCacheEnabled = false;
     DrawObjectsLogger* m_drawObjectsLogger = nullptr;
     Font m_font;
     Pen m_pen;
@@ -331,9 +331,12 @@ void CmdState::dump()
 //---------------------------------------------------------
 //   update
 //    layout & update
+//    if layoutAllParts is false, only this score is laid out;
+//    together with resetCmdState = false the layout range is
+//    kept, so that the next full update lays out the other parts
 //---------------------------------------------------------
 
-void Score::update(bool resetCmdState)
+void Score::update(bool resetCmdState, bool layoutAllParts)
 {
     bool updateAll = false;
     {
@@ -341,8 +344,12 @@ void Score::update(bool resetCmdState)
         CmdState& cs = ms->cmdState();
         ms->deletePostponed();
         if (cs.layoutRange()) {
-            for (Score* s : ms->scoreList()) {
-                s->doLayoutRange(cs.startTick(), cs.endTick());
+            if (layoutAllParts) {
+                for (Score* s : ms->scoreList()) {
+                    s->doLayoutRange(cs.startTick(), cs.endTick());
+                }
+            } else {
+                doLayoutRange(cs.startTick(), cs.endTick());
             }
             updateAll = true;
         }
@@ -42,6 +42,8 @@ QList<InstrumentGenre*> instrumentGenres;
 QList<InstrumentFamily*> instrumentFamilies;
 QList<ScoreOrder> instrumentOrders;
 
+static std::function<void()> s_instrumentTemplatesLoader;
+
 //---------------------------------------------------------
 //   searchInstrumentGenre
 //---------------------------------------------------------
@@ -707,12 +709,44 @@ bool loadInstrumentTemplates(const QString& instrTemplates)
     return true;
 }
 
+//---------------------------------------------------------
+//   setInstrumentTemplatesLoader
+//    defers loading of the templates until they are used
+//    for the first time, see ensureInstrumentTemplatesLoaded()
+//---------------------------------------------------------
+
+void setInstrumentTemplatesLoader(const std::function<void()>& loader)
+{
+    s_instrumentTemplatesLoader = loader;
+}
+
+//---------------------------------------------------------
+//   ensureInstrumentTemplatesLoaded
+//    must be called before accessing the global template
+//    lists directly; not thread safe, so call it from the
+//    main thread before starting any parallel work
+//---------------------------------------------------------
+
+void ensureInstrumentTemplatesLoaded()
+{
+    if (!s_instrumentTemplatesLoader) {
+        return;
+    }
+
+    //! NOTE Reset before calling, the templates themselves are searched while loading
+    std::function<void()> loader = std::move(s_instrumentTemplatesLoader);
+    s_instrumentTemplatesLoader = nullptr;
+    loader();
+}
+
 //---------------------------------------------------------
 //   searchTemplate
 //---------------------------------------------------------
 
 InstrumentTemplate* searchTemplate(const QString& name)
 {
+    ensureInstrumentTemplatesLoaded();
+
     for (InstrumentGroup* g : qAsConst(instrumentGroups)) {
         for (InstrumentTemplate* it : qAsConst(g->instrumentTemplates)) {
             if (it->id == name) {
@@ -729,6 +763,8 @@ InstrumentTemplate* searchTemplate(const QString& name)
 
 InstrumentTemplate* searchTemplateForMusicXmlId(const QString& mxmlId)
 {
+    ensureInstrumentTemplatesLoaded();
+
     for (InstrumentGroup* g : qAsConst(instrumentGroups)) {
         for (InstrumentTemplate* it : qAsConst(g->instrumentTemplates)) {
             if (it->musicXMLid == mxmlId) {
@@ -741,6 +777,8 @@ InstrumentTemplate* searchTemplateForMusicXmlId(const QString& mxmlId)
 
 InstrumentTemplate* searchTemplateForInstrNameList(const QList<QString>& nameList)
 {
+    ensureInstrumentTemplatesLoaded();
+
     InstrumentTemplate* bestMatch = nullptr; // default if no matches
     int bestMatchStrength = 0; // higher for better matches
     for (InstrumentGroup* g : qAsConst(instrumentGroups)) {
@@ -771,6 +809,8 @@ InstrumentTemplate* searchTemplateForInstrNameList(const QList<QString>& nameLis
 
 InstrumentTemplate* searchTemplateForMidiProgram(int midiProgram, const bool useDrumSet)
 {
+    ensureInstrumentTemplatesLoaded();
+
     for (InstrumentGroup* g : qAsConst(instrumentGroups)) {
         for (InstrumentTemplate* it : qAsConst(g->instrumentTemplates)) {
             if (it->channel.empty() || it->useDrumset != useDrumSet) {
@@ -787,6 +827,8 @@ InstrumentTemplate* searchTemplateForMidiProgram(int midiProgram, const bool use
 
 InstrumentTemplate* guessTemplateByNameData(const QList<QString>& nameDataList)
 {
+    ensureInstrumentTemplatesLoaded();
+
     for (InstrumentGroup* g : qAsConst(instrumentGroups)) {
         for (InstrumentTemplate* it : qAsConst(g->instrumentTemplates)) {
             for (const QString& name : nameDataList) {
@@ -818,6 +860,8 @@ InstrumentTemplate* guessTemplateByNameData(const QList<QString>& nameDataList)
 
 InstrumentIndex searchTemplateIndexForTrackName(const QString& trackName)
 {
+    ensureInstrumentTemplatesLoaded();
+
     int instIndex = 0;
     int grpIndex = 0;
     for (InstrumentGroup* g : qAsConst(instrumentGroups)) {
@@ -838,6 +882,8 @@ InstrumentIndex searchTemplateIndexForTrackName(const QString& trackName)
 
 InstrumentIndex searchTemplateIndexForId(const QString& id)
 {
+    ensureInstrumentTemplatesLoaded();
+
     int instIndex = 0;
     int grpIndex = 0;
     for (InstrumentGroup* g : instrumentGroups) {
@@ -960,6 +1006,8 @@ ClefType defaultClef(int program)
         return ClefType::F8_VB;
     }
 
+    ensureInstrumentTemplatesLoaded();
+
     for (InstrumentGroup* g : qAsConst(instrumentGroups)) {
         for (InstrumentTemplate* it : qAsConst(g->instrumentTemplates)) {
             if (it->channel[0].bank() == 0 && it->channel[0].program() == program) {
@@ -23,6 +23,8 @@
 #ifndef __INSTRTEMPLATE_H__
 #define __INSTRTEMPLATE_H__
 
+#include <functional>
+
 #include "mscore.h"
 #include "instrument.h"
 #include "clef.h"
@@ -172,6 +174,8 @@ extern QList<InstrumentGroup*> instrumentGroups;
 extern QList<ScoreOrder> instrumentOrders;
 extern void clearInstrumentTemplates();
 extern bool loadInstrumentTemplates(const QString& instrTemplates);
+extern void setInstrumentTemplatesLoader(const std::function<void()>& loader);
+extern void ensureInstrumentTemplatesLoaded();
 extern InstrumentTemplate* searchTemplate(const QString& name);
 extern InstrumentIndex searchTemplateIndexForTrackName(const QString& trackName);
 extern InstrumentIndex searchTemplateIndexForId(const QString& id);
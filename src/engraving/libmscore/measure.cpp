@@ -137,6 +137,7 @@ MStaff::MStaff(const MStaff& m)
     m_corrupted = m.m_corrupted;
 #endif
     m_measureRepeatCount = 0;
+    m_contentHash = m.m_contentHash;
 }
 
 //---------------------------------------------------------
@@ -361,6 +362,50 @@ MMRestRange* Measure::mmRangeText(int staffIdx) const
     return m_mstaves[staffIdx]->mmRangeText();
 }
 
+//---------------------------------------------------------
+//   contentHash
+//    Changes whenever an undoable edit touches the content
+//    of the measure (or of the given staff of it), or
+//    anything that may affect every measure of the score.
+//    Undoing an edit gives back the previous value, so
+//    consumers may keep results computed for a hash.
+//---------------------------------------------------------
+
+uint64_t Measure::contentHash(int staffIdx) const
+{
+    return (m_mstaves[staffIdx]->contentHash() * 0x9E3779B97F4A7C15ULL) ^ score()->undoStack()->globalContentHash();
+}
+
+uint64_t Measure::contentHash() const
+{
+    uint64_t h = score()->undoStack()->globalContentHash();
+    for (const MStaff* ms : m_mstaves) {
+        h = (h ^ ms->contentHash()) * 0x100000001B3ULL;
+    }
+    return h;
+}
+
+//---------------------------------------------------------
+//   toggleContentHash
+//    staffIdx -1 toggles all staves. Returns false if
+//    there is no such staff in the measure.
+//---------------------------------------------------------
+
+bool Measure::toggleContentHash(int staffIdx, uint64_t token)
+{
+    if (staffIdx < 0) {
+        for (MStaff* ms : m_mstaves) {
+            ms->toggleContentHash(token);
+        }
+        return true;
+    }
+    if (staffIdx >= int(m_mstaves.size())) {
+        return false;
+    }
+    m_mstaves[staffIdx]->toggleContentHash(token);
+    return true;
+}
+
 //---------------------------------------------------------
 //   Measure
 //---------------------------------------------------------
@@ -111,6 +111,9 @@ public:
     int measureRepeatCount() const { return m_measureRepeatCount; }
     void setMeasureRepeatCount(int n) { m_measureRepeatCount = n; }
 
+    uint64_t contentHash() const { return m_contentHash; }
+    void toggleContentHash(uint64_t token) { m_contentHash ^= token; }
+
 private:
     MeasureNumber* m_noText { nullptr };      ///< Measure number text object
     MMRestRange* m_mmRangeText { nullptr };    ///< Multi measure rest range text object
@@ -125,6 +128,7 @@ private:
     bool m_corrupted        { false };
 #endif
     int m_measureRepeatCount { 0 };
+    uint64_t m_contentHash  { 0 };    ///< maintained by UndoStack, see Measure::contentHash()
 };
 
 //---------------------------------------------------------
@@ -308,6 +312,10 @@ public:
     Measure* mmRestFirst() const;
     Measure* mmRestLast() const;
 
+    uint64_t contentHash() const;
+    uint64_t contentHash(int staffIdx) const;
+    bool toggleContentHash(int staffIdx, uint64_t token);
+
     int measureRepeatCount(int staffIdx) const { return m_mstaves[staffIdx]->measureRepeatCount(); }
     void setMeasureRepeatCount(int n, int staffIdx) { m_mstaves[staffIdx]->setMeasureRepeatCount(n); }
     bool isMeasureRepeatGroup(int staffIdx) const { return measureRepeatCount(staffIdx); }   // alias for convenience
@@ -105,6 +105,7 @@ int MScore::pedalEventsMinTicks;
 bool MScore::harmonyPlayDisableCompatibility;
 bool MScore::harmonyPlayDisableNew;
 bool MScore::playRepeats;
+size_t MScore::undoMemoryBudget = 0;
 int MScore::playbackSpeedIncrement;
 qreal MScore::nudgeStep;
 qreal MScore::nudgeStep10;
@@ -291,6 +291,7 @@ public:
     static bool harmonyPlayDisableCompatibility;
     static bool harmonyPlayDisableNew;
     static bool playRepeats;
+    static size_t undoMemoryBudget;   // approximate, in bytes; 0 - unlimited
     static int playbackSpeedIncrement;
     static qreal nudgeStep;
     static qreal nudgeStep10;
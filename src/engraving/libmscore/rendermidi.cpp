@@ -29,6 +29,9 @@
 
 #include <set>
 #include <cmath>
+#include <queue>
+
+#include <QtConcurrent>
 
 #include "style/style.h"
 #include "compat/midi/event.h"
@@ -1133,11 +1136,16 @@ void Score::updateVelo()
 }
 
 //---------------------------------------------------------
-//   renderStaffChunk
+//   staffChunkMeasures
+///   Measures played on the staff in the chunk, with the
+///   tick offsets they are played at. Measure repeats play
+///   the measures they repeat.
 //---------------------------------------------------------
 
-void MidiRenderer::renderStaffChunk(const Chunk& chunk, EventMap* events, const StaffContext& sctx)
+std::vector<std::pair<Measure const*, int> > MidiRenderer::staffChunkMeasures(const Chunk& chunk, int staffIdx)
 {
+    std::vector<std::pair<Measure const*, int> > result;
+
     Measure const* const start = chunk.startMeasure();
     Measure const* const end = chunk.endMeasure();
     const int tickOffset = chunk.tickOffset();
@@ -1145,7 +1153,6 @@ void MidiRenderer::renderStaffChunk(const Chunk& chunk, EventMap* events, const
     Measure const* lastMeasure = start->prevMeasure();
 
     for (Measure const* m = start; m != end; m = m->nextMeasure()) {
-        int staffIdx = sctx.staff->idx();
         if (m->isMeasureRepeatGroup(staffIdx)) {
             MeasureRepeat* mr = m->measureRepeatElement(staffIdx);
             Measure const* playMeasure = lastMeasure;
@@ -1153,12 +1160,231 @@ void MidiRenderer::renderStaffChunk(const Chunk& chunk, EventMap* events, const
                 playMeasure = playMeasure->prevMeasure();
             }
             int offset = (m->tick() - playMeasure->tick()).ticks();
-            collectMeasureEvents(events, playMeasure, sctx, tickOffset + offset);
+            result.push_back({ playMeasure, tickOffset + offset });
         } else {
             lastMeasure = m;
-            collectMeasureEvents(events, lastMeasure, sctx, tickOffset);
+            result.push_back({ lastMeasure, tickOffset });
         }
     }
+
+    return result;
+}
+
+//---------------------------------------------------------
+//   lastDependentMeasure
+///   The last measure whose content the events of the
+///   given measure depend on: tied notes are rendered as
+///   one note, glissandos need their end note.
+//---------------------------------------------------------
+
+static Measure const* lastDependentMeasure(Measure const* m, int staffIdx)
+{
+    Measure const* last = m;
+
+    auto updateLast = [&last](const Note* note) {
+        Measure const* nm = note->chord()->measure();
+        if (nm && nm->tick() > last->tick()) {
+            last = nm;
+        }
+    };
+
+    const int strack = staffIdx * VOICES;
+    const int etrack = strack + VOICES;
+
+    for (Segment* seg = m->first(SegmentType::ChordRest); seg; seg = seg->next(SegmentType::ChordRest)) {
+        for (int track = strack; track < etrack; ++track) {
+            EngravingItem* e = seg->element(track);
+            if (!e || !e->isChord()) {
+                continue;
+            }
+
+            for (const Note* note : toChord(e)->notes()) {
+                const Note* n = note;
+                while (n->tieFor() && n->tieFor()->endNote() && n != n->tieFor()->endNote()) {
+                    n = n->tieFor()->endNote();
+                }
+                updateLast(n);
+
+                for (Spanner* sp : note->spannerFor()) {
+                    if (sp->endElement() && sp->endElement()->isNote()) {
+                        updateLast(toNote(sp->endElement()));
+                    }
+                }
+            }
+        }
+    }
+
+    return last;
+}
+
+//---------------------------------------------------------
+//   renderStaffChunk
+//---------------------------------------------------------
+
+void MidiRenderer::renderStaffChunk(const Chunk& chunk, EventMap* events, const StaffContext& sctx,
+                                    RenderedMeasureEvents* renderedMeasures)
+{
+    const int staffIdx = sctx.staff->idx();
+
+    for (const auto& measure : staffChunkMeasures(chunk, staffIdx)) {
+        Measure const* m = measure.first;
+        const int tickOffset = measure.second;
+
+        const MeasureEvents* measureEvents = cachedMeasureEvents(m, staffIdx, tickOffset);
+        if (!measureEvents) {
+            MeasureEvents rendered;
+            collectMeasureEvents(&rendered.events, m, sctx, tickOffset);
+            rendered.events.sort();
+            rendered.lastDependency = lastDependentMeasure(m, staffIdx);
+            rendered.contentHash = measureEventsHash(m, rendered.lastDependency, staffIdx);
+
+            if (renderedMeasures) {
+                // the cache is shared by the staves rendered concurrently, it is updated once they are done
+                renderedMeasures->emplace_back(MeasureEventsKey { m, staffIdx, tickOffset }, std::move(rendered));
+                measureEvents = &renderedMeasures->back().second;
+            } else {
+                MeasureEvents& cached = measureEventsCache[{ m, staffIdx, tickOffset }];
+                cached = std::move(rendered);
+                measureEvents = &cached;
+            }
+        }
+
+        events->insert(measureEvents->events.cbegin(), measureEvents->events.cend());
+        events->registerChannel(measureEvents->events.highestChannel());
+    }
+}
+
+//---------------------------------------------------------
+//   renderStavesConcurrently
+///   Renders every staff into its own events on the global
+///   thread pool. Merging them by tick, then by staff index
+///   gives exactly the events of the serial rendering.
+//---------------------------------------------------------
+
+void MidiRenderer::renderStavesConcurrently(const Chunk& chunk, EventMap* events, const StaffContext& sctx)
+{
+    struct StaffEvents
+    {
+        StaffContext sctx;
+        EventMap events;
+        RenderedMeasureEvents renderedMeasures;
+    };
+
+    std::vector<StaffEvents> staves(score->nstaves());
+    for (Staff* st : score->staves()) {
+        StaffEvents& staffEvents = staves[st->idx()];
+        staffEvents.sctx = sctx;
+        staffEvents.sctx.staff = st;
+
+        // the velocity maps clean themselves up on the first read
+        st->velocities().cleanup();
+        st->velocityMultiplications().cleanup();
+    }
+
+    QtConcurrent::blockingMap(staves, [this, &chunk](StaffEvents& staffEvents) {
+        renderStaffChunk(chunk, &staffEvents.events, staffEvents.sctx, &staffEvents.renderedMeasures);
+    });
+
+    // k-way merge, staves with events at the same tick are taken in the order of their indices
+    std::vector<std::pair<EventMap::const_iterator, EventMap::const_iterator> > cursors;
+    cursors.reserve(staves.size());
+    for (const StaffEvents& staffEvents : staves) {
+        cursors.emplace_back(staffEvents.events.cbegin(), staffEvents.events.cend());
+    }
+
+    auto later = [&cursors](size_t i1, size_t i2) {
+        const int tick1 = cursors[i1].first->first;
+        const int tick2 = cursors[i2].first->first;
+        return tick1 > tick2 || (tick1 == tick2 && i1 > i2);
+    };
+    std::priority_queue<size_t, std::vector<size_t>, decltype(later)> queue(later);
+
+    for (size_t i = 0; i < cursors.size(); ++i) {
+        if (cursors[i].first != cursors[i].second) {
+            queue.push(i);
+        }
+    }
+
+    while (!queue.empty()) {
+        const size_t i = queue.top();
+        queue.pop();
+
+        auto& cursor = cursors[i];
+        const int tick = cursor.first->first;
+        do {
+            events->insert(*cursor.first);
+            ++cursor.first;
+        } while (cursor.first != cursor.second && cursor.first->first == tick);
+
+        if (cursor.first != cursor.second) {
+            queue.push(i);
+        }
+    }
+
+    for (StaffEvents& staffEvents : staves) {
+        events->registerChannel(staffEvents.events.highestChannel());
+        for (auto& rendered : staffEvents.renderedMeasures) {
+            measureEventsCache[rendered.first] = std::move(rendered.second);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   validateMeasureEventsCache
+///   Forget all cached measure events when the rendering
+///   settings or anything not attributed to particular
+///   measures (tempo, dynamics, structure...) changed.
+//---------------------------------------------------------
+
+void MidiRenderer::validateMeasureEventsCache(const StaffContext& sctx)
+{
+    const uint64_t globalHash = score->undoStack()->globalContentHash();
+
+    if (globalHash != measureEventsGlobalHash
+        || sctx.method != measureEventsContext.method
+        || sctx.cc != measureEventsContext.cc
+        || sctx.renderHarmony != measureEventsContext.renderHarmony) {
+        measureEventsCache.clear();
+        measureEventsGlobalHash = globalHash;
+        measureEventsContext = sctx;
+    }
+}
+
+//---------------------------------------------------------
+//   cachedMeasureEvents
+///   Cached events of a measure on a staff, nullptr if
+///   there are none or the measures were changed since.
+//---------------------------------------------------------
+
+const MidiRenderer::MeasureEvents* MidiRenderer::cachedMeasureEvents(Measure const* m, int staffIdx, int tickOffset) const
+{
+    auto it = measureEventsCache.find({ m, staffIdx, tickOffset });
+    if (it == measureEventsCache.end()) {
+        return nullptr;
+    }
+
+    const MeasureEvents& measureEvents = it->second;
+    if (measureEvents.contentHash != measureEventsHash(m, measureEvents.lastDependency, staffIdx)) {
+        return nullptr;
+    }
+
+    return &measureEvents;
+}
+
+//---------------------------------------------------------
+//   measureEventsHash
+//---------------------------------------------------------
+
+uint64_t MidiRenderer::measureEventsHash(Measure const* m, Measure const* lastDependency, int staffIdx) const
+{
+    uint64_t h = 0;
+    for (Measure const* dm = m; dm; dm = dm->nextMeasure()) {
+        h = (h ^ dm->contentHash(staffIdx)) * 0x100000001B3ULL;
+        if (dm == lastDependency) {
+            break;
+        }
+    }
+    return h;
 }
 
 //---------------------------------------------------------
@@ -2474,6 +2700,7 @@ void Score::renderMidi(EventMap* events, bool metronome, bool expandRepeats, con
     ctx.synthState = synthState;
     ctx.metronome = metronome;
     ctx.renderHarmony = true;
+    ctx.renderStavesConcurrently = true;
     MidiRenderer(this).renderScore(events, ctx);
     masterScore()->setExpandRepeats(expandRepeatsBackup);
 }
@@ -2488,12 +2715,6 @@ void MidiRenderer::renderScore(EventMap* events, const Context& ctx)
 
 void MidiRenderer::renderChunk(const Chunk& chunk, EventMap* events, const Context& ctx)
 {
-    // TODO: avoid doing it multiple times for the same measures
-    score->createPlayEvents(chunk.startMeasure(), chunk.endMeasure());
-
-    score->updateChannel();
-    score->updateVelo();
-
     SynthesizerState s = score->synthesizerState();
     int method = s.method();
     int cc = s.ccToUse();
@@ -2528,14 +2749,44 @@ void MidiRenderer::renderChunk(const Chunk& chunk, EventMap* events, const Conte
         break;
     }
 
-    // create note & other events
+    StaffContext sctx;
+    sctx.method = renderMethod;
+    sctx.cc = cc;
+    sctx.renderHarmony = ctx.renderHarmony;
+
+    validateMeasureEventsCache(sctx);
+
+    // play events, channels and velocities are only needed
+    // to render the measures which aren't cached
+    bool allMeasuresCached = true;
     for (Staff* st : score->staves()) {
-        StaffContext sctx;
-        sctx.staff = st;
-        sctx.method = renderMethod;
-        sctx.cc = cc;
-        sctx.renderHarmony = ctx.renderHarmony;
-        renderStaffChunk(chunk, events, sctx);
+        const int staffIdx = st->idx();
+        for (const auto& measure : staffChunkMeasures(chunk, staffIdx)) {
+            if (!cachedMeasureEvents(measure.first, staffIdx, measure.second)) {
+                allMeasuresCached = false;
+                break;
+            }
+        }
+        if (!allMeasuresCached) {
+            break;
+        }
+    }
+
+    if (!allMeasuresCached) {
+        score->createPlayEvents(chunk.startMeasure(), chunk.endMeasure());
+
+        score->updateChannel();
+        score->updateVelo();
+    }
+
+    // create note & other events
+    if (ctx.renderStavesConcurrently && score->nstaves() > 1) {
+        renderStavesConcurrently(chunk, events, sctx);
+    } else {
+        for (Staff* st : score->staves()) {
+            sctx.staff = st;
+            renderStaffChunk(chunk, events, sctx);
+        }
     }
     events->fixupMIDI();
 
@@ -2546,28 +2797,32 @@ void MidiRenderer::renderChunk(const Chunk& chunk, EventMap* events, const Conte
         renderMetronome(chunk, events);
     }
 
+    renderedChunks[chunk.utick1()] = { chunk, score->undoStack()->globalContentHash(), chunkContentHash(chunk) };
+
     // NOTE:JT this is a temporary fix for duplicate events until polyphonic aftertouch support
     // can be implemented. This removes duplicate SND events.
     int lastChannel = -1;
     int lastController = -1;
     int lastValue = -1;
-    for (auto i = events->begin(); i != events->end();) {
+    auto kept = events->begin();
+    for (auto i = events->begin(); i != events->end(); ++i) {
         if (i->second.type() == ME_CONTROLLER) {
             auto& event = i->second;
             if (event.channel() == lastChannel
                 && event.controller() == lastController
                 && event.value() == lastValue) {
-                i = events->erase(i);
-            } else {
-                lastChannel = event.channel();
-                lastController = event.controller();
-                lastValue = event.value();
-                i++;
+                continue;
             }
-        } else {
-            i++;
+            lastChannel = event.channel();
+            lastController = event.controller();
+            lastValue = event.value();
         }
+        if (kept != i) {
+            *kept = std::move(*i);
+        }
+        ++kept;
     }
+    events->erase(kept, events->end());
 }
 
 //---------------------------------------------------------
@@ -2678,6 +2933,71 @@ void MidiRenderer::updateChunksPartition()
     }
 }
 
+//---------------------------------------------------------
+//   MidiRenderer::chunkContentHash
+//---------------------------------------------------------
+
+uint64_t MidiRenderer::chunkContentHash(const Chunk& chunk) const
+{
+    uint64_t h = 0;
+    for (Measure const* m = chunk.startMeasure(); m && m != chunk.endMeasure(); m = m->nextMeasure()) {
+        h = (h ^ m->contentHash()) * 0x100000001B3ULL;
+
+        // measure repeats are played from the preceding measures
+        for (const Staff* staff : score->staves()) {
+            const int staffIdx = staff->idx();
+            if (!m->isMeasureRepeatGroup(staffIdx)) {
+                continue;
+            }
+            const Measure* rm = m->firstOfMeasureRepeatGroup(staffIdx);
+            const MeasureRepeat* mr = m->measureRepeatElement(staffIdx);
+            for (int i = 0; rm && mr && i < mr->numMeasures(); ++i) {
+                rm = rm->prevMeasure();
+                if (rm) {
+                    h = (h ^ rm->contentHash(staffIdx)) * 0x100000001B3ULL;
+                }
+            }
+        }
+    }
+    return h;
+}
+
+//---------------------------------------------------------
+//   MidiRenderer::setContentChanged
+//    Content hashes are maintained by the undo stack,
+//    changes bypassing it can't be found by them
+//---------------------------------------------------------
+
+void MidiRenderer::setContentChanged()
+{
+    measureEventsCache.clear();
+    renderedChunks.clear();
+    needUpdate = true;
+}
+
+//---------------------------------------------------------
+//   MidiRenderer::changedChunks
+//---------------------------------------------------------
+
+std::vector<MidiRenderer::Chunk> MidiRenderer::changedChunks()
+{
+    std::vector<Chunk> result;
+    const uint64_t globalHash = score->undoStack()->globalContentHash();
+
+    for (auto it = renderedChunks.begin(); it != renderedChunks.end();) {
+        const RenderedChunk& rendered = it->second;
+        // measures of the chunk may not exist anymore if the global hash changed
+        if (rendered.globalHash != globalHash || rendered.contentHash != chunkContentHash(rendered.chunk)) {
+            result.push_back(rendered.chunk);
+            it = renderedChunks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    return result;
+}
+
 std::vector<MidiRenderer::Chunk> MidiRenderer::chunksFromRange(const int fromTick, const int toTick)
 {
     std::vector<Chunk> result;
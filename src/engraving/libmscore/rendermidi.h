@@ -23,11 +23,14 @@
 #ifndef __RENDERMIDI_H__
 #define __RENDERMIDI_H__
 
+#include <map>
+#include <tuple>
+
+#include "compat/midi/event.h"
 #include "measure.h"
 #include "synthesizerstate.h"
 
 namespace Ms {
-class EventMap;
 class MasterScore;
 class Staff;
 class SynthesizerState;
@@ -101,6 +104,14 @@ public:
 private:
     std::vector<Chunk> chunks;
 
+    struct RenderedChunk
+    {
+        Chunk chunk;
+        uint64_t globalHash = 0;
+        uint64_t contentHash = 0;
+    };
+    std::map<int, RenderedChunk> renderedChunks;   // by utick1
+
     struct StaffContext
     {
         Staff* staff{ nullptr };
@@ -109,11 +120,30 @@ private:
         bool renderHarmony{ false };
     };
 
+    //! Events of a measure on a staff, as long as the measures they were rendered from are unchanged
+    struct MeasureEvents
+    {
+        EventMap events;
+        Measure const* lastDependency{ nullptr };   // tied notes and glissandos may end in the next measures
+        uint64_t contentHash{ 0 };
+    };
+    using MeasureEventsKey = std::tuple<Measure const*, int /*staffIdx*/, int /*tickOffset*/>;
+    using RenderedMeasureEvents = std::vector<std::pair<MeasureEventsKey, MeasureEvents> >;
+    std::map<MeasureEventsKey, MeasureEvents> measureEventsCache;
+    uint64_t measureEventsGlobalHash{ 0 };
+    StaffContext measureEventsContext;
+
     void updateChunksPartition();
     static bool canBreakChunk(const Measure* last);
+    uint64_t chunkContentHash(const Chunk&) const;
     void updateState();
 
-    void renderStaffChunk(const Chunk&, EventMap* events, const StaffContext& sctx);
+    static std::vector<std::pair<Measure const*, int> > staffChunkMeasures(const Chunk&, int staffIdx);
+    void renderStaffChunk(const Chunk&, EventMap* events, const StaffContext& sctx, RenderedMeasureEvents* renderedMeasures = nullptr);
+    void renderStavesConcurrently(const Chunk&, EventMap* events, const StaffContext& sctx);
+    void validateMeasureEventsCache(const StaffContext& sctx);
+    const MeasureEvents* cachedMeasureEvents(Measure const* m, int staffIdx, int tickOffset) const;
+    uint64_t measureEventsHash(Measure const* m, Measure const* lastDependency, int staffIdx) const;
     void renderSpanners(const Chunk&, EventMap* events);
     void renderMetronome(const Chunk&, EventMap* events);
     void renderMetronome(EventMap* events, Measure const* m, const Fraction& tickOffset);
@@ -130,6 +160,7 @@ public:
         Ms::SynthesizerState synthState;
         bool metronome{ true };
         bool renderHarmony{ false };
+        bool renderStavesConcurrently{ false };     // gives the same events as the serial rendering
 
         Context() {}
     };
@@ -138,11 +169,16 @@ public:
     void renderChunk(const Chunk&, EventMap* events, const Context& ctx);
 
     void setScoreChanged() { needUpdate = true; }
+    void setContentChanged();   // by changes bypassing the undo stack, forgets everything rendered
     void setMinChunkSize(int sizeMeasures) { minChunkSize = sizeMeasures; needUpdate = true; }
 
     static const int ARTICULATION_CONV_FACTOR { 100000 };
 
     std::vector<Chunk> chunksFromRange(const int fromTick, const int toTick);
+
+    //! Chunks rendered before whose measures were changed since then.
+    //! They are forgotten as rendered once returned.
+    std::vector<Chunk> changedChunks();
 };
 
 class Spanner;
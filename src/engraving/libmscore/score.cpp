@@ -5187,6 +5187,7 @@ void Score::doLayoutRange(const Fraction& st, const Fraction& et)
 
     m_layoutOptions.updateFromStyle(style());
     m_layout.doLayoutRange(m_layoutOptions, st, et);
+    ++m_layoutGeneration;
 }
 
 UndoStack* Score::undoStack() const { return _masterScore->undoStack(); }
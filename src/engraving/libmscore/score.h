@@ -474,6 +474,7 @@ private:
     mu::engraving::RootItem* m_rootItem = nullptr;
     mu::engraving::Layout m_layout;
     mu::engraving::LayoutOptions m_layoutOptions;
+    int m_layoutGeneration = 0;
 
     Note* getSelectedNote();
     ChordRest* nextTrack(ChordRest* cr, bool skipMeasureRepeatRests = true);
@@ -507,7 +508,7 @@ private:
     void deleteAnnotationsFromRange(Segment* segStart, Segment* segEnd, int trackStart, int trackEnd, const SelectionFilter& filter);
     ChordRest* deleteRange(Segment* segStart, Segment* segEnd, int trackStart, int trackEnd, const SelectionFilter& filter);
 
-    void update(bool resetCmdState);
+    void update(bool resetCmdState, bool layoutAllParts = true);
 
     ID newStaffId() const;
     ID newPartId() const;
@@ -751,6 +752,7 @@ public:
     void startCmd();                    // start undoable command
     void endCmd(bool rollback = false); // end undoable command
     void update() { update(true); }
+    void updateDrag() { update(false, false); } // lays out only this score, the linked parts are laid out by endCmd()
     void undoRedo(bool undo, EditData*);
 
     void cmdRemoveTimeSig(TimeSig*);
@@ -1046,6 +1048,7 @@ public:
 
     void doLayout();
     void doLayoutRange(const Fraction& st, const Fraction& et);
+    int layoutGeneration() const { return m_layoutGeneration; } // changes on every layout, whatever has caused it
 
     SynthesizerState& synthesizerState() { return _synthesizerState; }
     void setSynthesizerState(const SynthesizerState& s);
@@ -40,6 +40,32 @@ using namespace mu;
 using namespace mu::engraving;
 
 namespace Ms {
+//---------------------------------------------------------
+//   LineBlock
+//    A range of MSCX lines: either a whole element with a
+//    block tag (e.g. <Measure>...</Measure>) or a single line.
+//    The hash is combined from the line hashes, so equal
+//    subtrees are matched without comparing their text
+//    unless the hashes collide.
+//---------------------------------------------------------
+
+struct LineBlock {
+    const std::vector<QStringRef>* lines = nullptr;
+    int begin = 0;
+    int end = 0;
+    uint hash = 0;
+
+    int size() const { return end - begin; }
+
+    bool operator==(const LineBlock& other) const
+    {
+        return hash == other.hash && size() == other.size()
+               && std::equal(lines->begin() + begin, lines->begin() + end, other.lines->begin() + other.begin);
+    }
+};
+
+using LineSes = std::vector<std::pair<QStringRef, dtl::edit_t> >;
+
 //---------------------------------------------------------
 //   MscxModeDiff
 //---------------------------------------------------------
@@ -63,6 +89,21 @@ class MscxModeDiff
 
     static DiffType fromDtlDiffType(dtl::edit_t dtlType);
 
+    struct LineRange {
+        const std::vector<QStringRef>& lines;
+        const std::vector<uint>& hashes;
+        int begin;
+        int end;
+
+        bool empty() const { return begin == end; }
+    };
+
+    static bool isBlockTag(const QStringRef& line, const QLatin1String& tag, bool endTag);
+    static std::vector<LineBlock> splitBlocks(const LineRange& range, const QLatin1String& tag);
+    static void appendLines(LineSes& ses, const LineRange& range, dtl::edit_t type);
+    static void lineDiff(LineSes& ses, const LineRange& range1, const LineRange& range2);
+    static void structuralDiff(LineSes& ses, const LineRange& range1, const LineRange& range2, size_t level);
+
     void adjustSemanticsMscx(std::vector<TextDiff>&);
     int adjustSemanticsMscxOneDiff(std::vector<TextDiff>& diffs, int index);
     int nextDiffOnShiftIndex(const std::vector<TextDiff>& diffs, int index, bool down);
@@ -132,34 +173,211 @@ DiffType MscxModeDiff::fromDtlDiffType(dtl::edit_t dtlType)
     return DiffType::EQUAL;
 }
 
+//---------------------------------------------------------
+//   blockTags
+//    Tags of the MSCX elements that are compared as a whole
+//    by their hash before descending into their content,
+//    from the outermost to the innermost level.
+//---------------------------------------------------------
+
+static const QLatin1String blockTags[] = { QLatin1String("Staff"), QLatin1String("Measure") };
+static constexpr size_t blockLevels = sizeof(blockTags) / sizeof(blockTags[0]);
+
+//---------------------------------------------------------
+//   MscxModeDiff::isBlockTag
+//    Checks whether the line opens (or closes) an element
+//    with the given tag. Self-closing tags are not counted
+//    as opening ones.
+//---------------------------------------------------------
+
+bool MscxModeDiff::isBlockTag(const QStringRef& line, const QLatin1String& tag, bool endTag)
+{
+    const QStringRef trimmed = line.trimmed();
+    const int tagStart = endTag ? 2 : 1;
+    if (trimmed.size() <= tagStart + tag.size()
+        || trimmed.at(0) != '<'
+        || (endTag && trimmed.at(1) != '/')
+        || trimmed.mid(tagStart, tag.size()) != tag) {
+        return false;
+    }
+
+    const QChar next = trimmed.at(tagStart + tag.size());
+    if (endTag) {
+        return next == '>';
+    }
+    return (next == '>' || next == ' ') && !trimmed.endsWith(QLatin1String("/>"));
+}
+
+//---------------------------------------------------------
+//   MscxModeDiff::splitBlocks
+//    Splits the line range into elements with the given
+//    tag and single lines between them.
+//---------------------------------------------------------
+
+std::vector<LineBlock> MscxModeDiff::splitBlocks(const LineRange& range, const QLatin1String& tag)
+{
+    std::vector<LineBlock> blocks;
+    int i = range.begin;
+    while (i < range.end) {
+        int blockEnd = i + 1;
+        if (isBlockTag(range.lines[i], tag, false)) {
+            int depth = 1;
+            while (blockEnd < range.end && depth > 0) {
+                if (isBlockTag(range.lines[blockEnd], tag, true)) {
+                    --depth;
+                } else if (isBlockTag(range.lines[blockEnd], tag, false)) {
+                    ++depth;
+                }
+                ++blockEnd;
+            }
+        }
+
+        LineBlock b;
+        b.lines = &range.lines;
+        b.begin = i;
+        b.end = blockEnd;
+        for (int l = i; l < blockEnd; ++l) {
+            b.hash = b.hash * 31 + range.hashes[l];
+        }
+        blocks.push_back(b);
+        i = blockEnd;
+    }
+    return blocks;
+}
+
+//---------------------------------------------------------
+//   MscxModeDiff::appendLines
+//---------------------------------------------------------
+
+void MscxModeDiff::appendLines(LineSes& ses, const LineRange& range, dtl::edit_t type)
+{
+    for (int i = range.begin; i < range.end; ++i) {
+        ses.emplace_back(range.lines[i], type);
+    }
+}
+
+//---------------------------------------------------------
+//   MscxModeDiff::lineDiff
+//    Plain line diff of the given ranges
+//---------------------------------------------------------
+
+void MscxModeDiff::lineDiff(LineSes& ses, const LineRange& range1, const LineRange& range2)
+{
+    typedef std::pair<QStringRef, dtl::elemInfo> sesElem;
+
+    std::vector<QStringRef> lines1(range1.lines.begin() + range1.begin, range1.lines.begin() + range1.end);
+    std::vector<QStringRef> lines2(range2.lines.begin() + range2.begin, range2.lines.begin() + range2.end);
+    dtl::Diff<QStringRef, std::vector<QStringRef> > diff(lines1, lines2);
+    diff.compose();
+
+    for (const sesElem& ch : diff.getSes().getSequence()) {
+        ses.emplace_back(ch.first, ch.second.type);
+    }
+}
+
+//---------------------------------------------------------
+//   MscxModeDiff::structuralDiff
+//    Diffs the ranges as sequences of blocks of the given
+//    level, so that equal staves and measures are matched
+//    by their hashes. Only the ranges between matched
+//    blocks are descended into, down to a line diff at the
+//    innermost level.
+//---------------------------------------------------------
+
+void MscxModeDiff::structuralDiff(LineSes& ses, const LineRange& range1, const LineRange& range2, size_t level)
+{
+    if (range1.empty() || range2.empty()) {
+        appendLines(ses, range1, dtl::SES_DELETE);
+        appendLines(ses, range2, dtl::SES_ADD);
+        return;
+    }
+    if (level == blockLevels) {
+        lineDiff(ses, range1, range2);
+        return;
+    }
+
+    const std::vector<LineBlock> blocks1 = splitBlocks(range1, blockTags[level]);
+    const std::vector<LineBlock> blocks2 = splitBlocks(range2, blockTags[level]);
+    if (int(blocks1.size()) == range1.end - range1.begin && int(blocks2.size()) == range2.end - range2.begin) {
+        // no blocks of this level here
+        structuralDiff(ses, range1, range2, level + 1);
+        return;
+    }
+
+    typedef std::pair<LineBlock, dtl::elemInfo> sesElem;
+    dtl::Diff<LineBlock, std::vector<LineBlock> > diff(blocks1, blocks2);
+    diff.compose();
+
+    // SES lists blocks in order, so the changed ranges are the
+    // ones between consecutive common blocks.
+    int pos1 = range1.begin;
+    int pos2 = range2.begin;
+    int changedStart1 = pos1;
+    int changedStart2 = pos2;
+
+    auto descendChanged = [&]() {
+        if (changedStart1 != pos1 || changedStart2 != pos2) {
+            structuralDiff(ses, { range1.lines, range1.hashes, changedStart1, pos1 },
+                           { range2.lines, range2.hashes, changedStart2, pos2 }, level + 1);
+        }
+    };
+
+    for (const sesElem& ch : diff.getSes().getSequence()) {
+        const LineBlock& block = ch.first;
+        switch (ch.second.type) {
+        case dtl::SES_DELETE:
+            pos1 = block.end;
+            break;
+        case dtl::SES_ADD:
+            pos2 = block.end;
+            break;
+        case dtl::SES_COMMON:
+            // common elements are taken from the first sequence
+            descendChanged();
+            appendLines(ses, { range1.lines, range1.hashes, block.begin, block.end }, dtl::SES_COMMON);
+            pos1 = block.end;
+            pos2 += block.size();
+            changedStart1 = pos1;
+            changedStart2 = pos2;
+            break;
+        }
+    }
+    descendChanged();
+}
+
 //---------------------------------------------------------
 //   MscxModeDiff::lineModeDiff
 //---------------------------------------------------------
 
 std::vector<TextDiff> MscxModeDiff::lineModeDiff(const QString& s1, const QString& s2)
 {
-    // type declarations for dtl library
-    typedef QStringRef elem;
-    typedef std::pair<elem, dtl::elemInfo> sesElem;
-    typedef std::vector<sesElem> sesElemVec;
-
     const QVector<QStringRef> linesVec1 = s1.splitRef('\n');
-    std::vector<QStringRef> lines1(linesVec1.begin(), linesVec1.end());
+    const std::vector<QStringRef> lines1(linesVec1.begin(), linesVec1.end());
     const QVector<QStringRef> linesVec2 = s2.splitRef('\n');
-    std::vector<QStringRef> lines2(linesVec2.begin(), linesVec2.end());
-    dtl::Diff<QStringRef, std::vector<QStringRef> > diff(lines1, lines2);
+    const std::vector<QStringRef> lines2(linesVec2.begin(), linesVec2.end());
 
-    diff.compose();
+    std::vector<uint> hashes1;
+    hashes1.reserve(lines1.size());
+    for (const QStringRef& l : lines1) {
+        hashes1.push_back(qHash(l));
+    }
+    std::vector<uint> hashes2;
+    hashes2.reserve(lines2.size());
+    for (const QStringRef& l : lines2) {
+        hashes2.push_back(qHash(l));
+    }
+
+    LineSes changes;
+    structuralDiff(changes, { lines1, hashes1, 0, int(lines1.size()) }, { lines2, hashes2, 0, int(lines2.size()) }, 0);
 
-    const sesElemVec changes = diff.getSes().getSequence();
     std::vector<TextDiff> diffs;
     int line[2][2] { { 1, 1 }, { 1, 1 } }; // for correct assigning line numbers to
                                            // DELETE and INSERT diffs we need to
                                            // count lines separately for these diff
                                            // types (EQUAL can use both counters).
 
-    for (const sesElem& ch : changes) {
-        DiffType type = fromDtlDiffType(ch.second.type);
+    for (const auto& ch : changes) {
+        DiffType type = fromDtlDiffType(ch.second);
         const int iThis = (type == DiffType::DELETE) ? 0 : 1;     // for EQUAL doesn't matter
 
         if (diffs.empty() || diffs.back().type != type) {
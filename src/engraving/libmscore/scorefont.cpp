@@ -21,13 +21,19 @@
  */
 #include "scorefont.h"
 
+#include <cstring>
+
+#include <QCryptographicHash>
+#include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonParseError>
 
 #include "log.h"
+#include "global/version.h"
 
 #include "draw/painter.h"
 #include "mscore.h"
@@ -50,6 +56,143 @@ std::vector<ScoreFont> ScoreFont::s_scoreFonts {
 
 std::array<uint, size_t(SymId::lastSym) + 1> ScoreFont::s_symIdCodes { { 0 } };
 
+//! NOTE The cache is a flat binary file in the native byte order:
+//! a header (magic, version, key), followed by the payload.
+//! The key is a hash of all source files the payload was computed from,
+//! so a cache written for another version of the font is just ignored.
+
+static constexpr char CACHE_MAGIC[] = "MSFC";
+static constexpr quint32 CACHE_VERSION = 1;
+static constexpr int CACHE_KEY_SIZE = 20; // Sha1
+
+namespace {
+class CacheWriter
+{
+public:
+    template<typename T>
+    void write(const T& value)
+    {
+        m_data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    const QByteArray& data() const
+    {
+        return m_data;
+    }
+
+private:
+    QByteArray m_data;
+};
+
+class CacheReader
+{
+public:
+    CacheReader(const uchar* data, qint64 size)
+        : m_data(data), m_size(size) {}
+
+    template<typename T>
+    T read()
+    {
+        T value {};
+        if (m_pos + qint64(sizeof(T)) > m_size) {
+            m_ok = false;
+            return value;
+        }
+
+        std::memcpy(&value, m_data + m_pos, sizeof(T));
+        m_pos += sizeof(T);
+        return value;
+    }
+
+    bool ok() const
+    {
+        return m_ok;
+    }
+
+private:
+    const uchar* m_data = nullptr;
+    qint64 m_size = 0;
+    qint64 m_pos = 0;
+    bool m_ok = true;
+};
+}
+
+static QByteArray makeCacheKey(const std::initializer_list<QByteArray>& sources)
+{
+    //! NOTE The revision covers the compiled in tables, like the SymId names
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(reinterpret_cast<const char*>(&CACHE_VERSION), sizeof(CACHE_VERSION));
+    hash.addData(QByteArray::fromStdString(mu::framework::Version::revision()));
+    for (const QByteArray& source : sources) {
+        hash.addData(source);
+    }
+
+    return hash.result();
+}
+
+//! NOTE Maps the cache file into memory and checks its header,
+//! returns nullptr if the file is missing or out of date
+static const uchar* mapCacheFile(QFile& file, const QByteArray& key, qint64& payloadSize)
+{
+    if (file.fileName().isEmpty() || !file.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+
+    const qint64 headerSize = sizeof(CACHE_MAGIC) + sizeof(CACHE_VERSION) + CACHE_KEY_SIZE;
+    if (file.size() < headerSize) {
+        return nullptr;
+    }
+
+    const uchar* data = file.map(0, file.size());
+    if (!data) {
+        return nullptr;
+    }
+
+    CacheReader header(data, headerSize);
+    for (char ch : CACHE_MAGIC) {
+        if (header.read<char>() != ch) {
+            return nullptr;
+        }
+    }
+
+    if (header.read<quint32>() != CACHE_VERSION) {
+        return nullptr;
+    }
+
+    if (key != QByteArray::fromRawData(reinterpret_cast<const char*>(data) + headerSize - CACHE_KEY_SIZE, CACHE_KEY_SIZE)) {
+        return nullptr;
+    }
+
+    payloadSize = file.size() - headerSize;
+    return data + headerSize;
+}
+
+static void writeCacheFile(const QString& path, const QByteArray& key, const QByteArray& payload)
+{
+    if (path.isEmpty() || key.size() != CACHE_KEY_SIZE) {
+        return;
+    }
+
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    //! NOTE Write to a temporary file first, so that a concurrently starting instance never maps a partially written cache
+    QString tmpPath = path + ".tmp";
+    QFile file(tmpPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        LOGW() << "failed to write score font cache: " << path;
+        return;
+    }
+
+    file.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    file.write(reinterpret_cast<const char*>(&CACHE_VERSION), sizeof(CACHE_VERSION));
+    file.write(key);
+    file.write(payload);
+    file.close();
+
+    QFile::remove(path);
+    QFile::rename(tmpPath, path);
+}
+
 // =============================================
 // ScoreFont
 // =============================================
@@ -108,22 +251,38 @@ double ScoreFont::textEnclosureThickness()
 
 void ScoreFont::initScoreFonts()
 {
-    QJsonObject glyphNamesJson(ScoreFont::initGlyphNamesJson());
-    IF_ASSERT_FAILED(!glyphNamesJson.empty()) {
-        LOGE() << "Could not read glyph names JSON";
+    QFile glyphNamesFile(":fonts/smufl/glyphnames.json");
+    if (!glyphNamesFile.open(QIODevice::ReadOnly)) {
+        LOGE() << "could not open glyph names JSON file.";
         return;
     }
 
-    for (size_t i = 0; i < s_symIdCodes.size(); ++i) {
-        QString name(SymNames::nameForSymId(static_cast<SymId>(i)));
+    QByteArray glyphNamesData = glyphNamesFile.readAll();
+    glyphNamesFile.close();
 
-        bool ok;
-        uint code = glyphNamesJson.value(name).toObject().value("codepoint").toString().midRef(2).toUInt(&ok, 16);
-        if (ok) {
-            s_symIdCodes[i] = code;
-        } else if (MScore::debugMode) {
-            LOGD() << "could not read codepoint for glyph " << name;
+    QByteArray cacheKey = makeCacheKey({ glyphNamesData });
+    QString cachePath = cacheFilePath("glyphnames.cache");
+
+    if (!readGlyphNamesCache(cachePath, cacheKey)) {
+        QJsonObject glyphNamesJson(ScoreFont::initGlyphNamesJson(glyphNamesData));
+        IF_ASSERT_FAILED(!glyphNamesJson.empty()) {
+            LOGE() << "Could not read glyph names JSON";
+            return;
+        }
+
+        for (size_t i = 0; i < s_symIdCodes.size(); ++i) {
+            QString name(SymNames::nameForSymId(static_cast<SymId>(i)));
+
+            bool ok;
+            uint code = glyphNamesJson.value(name).toObject().value("codepoint").toString().midRef(2).toUInt(&ok, 16);
+            if (ok) {
+                s_symIdCodes[i] = code;
+            } else if (MScore::debugMode) {
+                LOGD() << "could not read codepoint for glyph " << name;
+            }
         }
+
+        writeGlyphNamesCache(cachePath, cacheKey);
     }
 
     fontProvider()->insertSubstitution("Leland Text",    "Bravura Text");
@@ -137,17 +296,10 @@ void ScoreFont::initScoreFonts()
     fallbackFont(); // load fallback font
 }
 
-QJsonObject ScoreFont::initGlyphNamesJson()
+QJsonObject ScoreFont::initGlyphNamesJson(const QByteArray& data)
 {
-    QFile file(":fonts/smufl/glyphnames.json");
-    if (!file.open(QIODevice::ReadOnly)) {
-        LOGE() << "could not open glyph names JSON file.";
-        return QJsonObject();
-    }
-
     QJsonParseError error;
-    QJsonObject glyphNamesJson = QJsonDocument::fromJson(file.readAll(), &error).object();
-    file.close();
+    QJsonObject glyphNamesJson = QJsonDocument::fromJson(data, &error).object();
 
     if (error.error != QJsonParseError::NoError) {
         LOGE() << "JSON parse error in glyph names file: " << error.errorString()
@@ -232,6 +384,24 @@ void ScoreFont::load()
     m_font.setNoFontMerging(true);
     m_font.setHinting(mu::draw::Font::Hinting::PreferVerticalHinting);
 
+    QFile faceFile(facePath);
+    QFile metadataFile(m_fontPath + "metadata.json");
+    if (!faceFile.open(QIODevice::ReadOnly) || !metadataFile.open(QIODevice::ReadOnly)) {
+        LOGE() << "Failed to open font files: " << facePath << ", " << metadataFile.fileName();
+        return;
+    }
+
+    QByteArray metadataData = metadataFile.readAll();
+    QByteArray symIdCodesData(reinterpret_cast<const char*>(s_symIdCodes.data()), int(s_symIdCodes.size() * sizeof(uint)));
+
+    QByteArray cacheKey = makeCacheKey({ faceFile.readAll(), metadataData, symIdCodesData });
+    QString cachePath = cacheFilePath(m_name.toLower() + ".cache");
+
+    if (readCache(cachePath, cacheKey)) {
+        m_loaded = true;
+        return;
+    }
+
     for (size_t id = 0; id < s_symIdCodes.size(); ++id) {
         uint code = s_symIdCodes[id];
         if (code == 0) {
@@ -241,14 +411,8 @@ void ScoreFont::load()
         computeMetrics(sym, code);
     }
 
-    QFile metadataFile(m_fontPath + "metadata.json");
-    if (!metadataFile.open(QIODevice::ReadOnly)) {
-        LOGE() << "Failed to open glyph metadata file: " << metadataFile.fileName();
-        return;
-    }
-
     QJsonParseError error;
-    QJsonObject metadataJson = QJsonDocument::fromJson(metadataFile.readAll(), &error).object();
+    QJsonObject metadataJson = QJsonDocument::fromJson(metadataData, &error).object();
     if (error.error != QJsonParseError::NoError) {
         LOGE() << "Json parse error in " << metadataFile.fileName()
                << ", offset " << error.offset << ": " << error.errorString();
@@ -260,6 +424,8 @@ void ScoreFont::load()
     loadStylisticAlternates(metadataJson.value("glyphsWithAlternates").toObject());
     loadEngravingDefaults(metadataJson.value("engravingDefaults").toObject());
 
+    writeCache(cachePath, cacheKey);
+
     m_loaded = true;
 }
 
@@ -578,6 +744,185 @@ void ScoreFont::computeMetrics(ScoreFont::Sym& sym, uint code)
     sym.advance = fontProvider()->symAdvance(m_font, code, DPI_F);
 }
 
+// =============================================
+// Cache
+// =============================================
+
+QString ScoreFont::cacheFilePath(const QString& fileName)
+{
+    if (!engravingConfiguration()) {
+        return QString();
+    }
+
+    QString dirPath = engravingConfiguration()->scoreFontsCachePath();
+    if (dirPath.isEmpty()) {
+        return QString();
+    }
+
+    return dirPath + "/" + fileName;
+}
+
+bool ScoreFont::readGlyphNamesCache(const QString& path, const QByteArray& key)
+{
+    QFile file(path);
+    qint64 size = 0;
+    const uchar* data = mapCacheFile(file, key, size);
+    if (!data) {
+        return false;
+    }
+
+    CacheReader reader(data, size);
+    if (reader.read<quint32>() != s_symIdCodes.size()) {
+        return false;
+    }
+
+    std::array<uint, size_t(SymId::lastSym) + 1> codes;
+    for (uint& code : codes) {
+        code = reader.read<quint32>();
+    }
+
+    if (!reader.ok()) {
+        return false;
+    }
+
+    s_symIdCodes = codes;
+    return true;
+}
+
+void ScoreFont::writeGlyphNamesCache(const QString& path, const QByteArray& key)
+{
+    CacheWriter writer;
+    writer.write(quint32(s_symIdCodes.size()));
+    for (uint code : s_symIdCodes) {
+        writer.write(quint32(code));
+    }
+
+    writeCacheFile(path, key, writer.data());
+}
+
+bool ScoreFont::readCache(const QString& path, const QByteArray& key)
+{
+    QFile file(path);
+    qint64 size = 0;
+    const uchar* data = mapCacheFile(file, key, size);
+    if (!data) {
+        return false;
+    }
+
+    CacheReader reader(data, size);
+
+    std::vector<Sym> symbols(m_symbols.size());
+    quint32 symbolsCount = reader.read<quint32>();
+    for (quint32 i = 0; i < symbolsCount && reader.ok(); ++i) {
+        quint32 id = reader.read<quint32>();
+        if (id >= symbols.size()) {
+            return false;
+        }
+
+        Sym& sym = symbols[id];
+        sym.code = reader.read<quint32>();
+        qreal x = reader.read<double>();
+        qreal y = reader.read<double>();
+        qreal w = reader.read<double>();
+        qreal h = reader.read<double>();
+        sym.bbox = RectF(x, y, w, h);
+        sym.advance = reader.read<double>();
+
+        quint8 anchorsCount = reader.read<quint8>();
+        for (quint8 a = 0; a < anchorsCount; ++a) {
+            SmuflAnchorId anchorId = static_cast<SmuflAnchorId>(reader.read<quint8>());
+            qreal ax = reader.read<double>();
+            qreal ay = reader.read<double>();
+            sym.smuflAnchors[anchorId] = PointF(ax, ay);
+        }
+
+        quint8 subSymbolsCount = reader.read<quint8>();
+        for (quint8 s = 0; s < subSymbolsCount; ++s) {
+            sym.subSymbolIds.push_back(static_cast<SymId>(reader.read<quint32>()));
+        }
+    }
+
+    std::list<std::pair<Sid, QVariant> > engravingDefaults;
+    quint32 defaultsCount = reader.read<quint32>();
+    for (quint32 i = 0; i < defaultsCount && reader.ok(); ++i) {
+        Sid sid = static_cast<Sid>(reader.read<qint32>());
+        qreal value = reader.read<double>();
+        engravingDefaults.push_back({ sid, value });
+    }
+    engravingDefaults.push_back({ Sid::MusicalTextFont, QString("%1 Text").arg(m_family) });
+
+    double textEnclosureThickness = reader.read<double>();
+
+    if (!reader.ok()) {
+        LOGW() << "corrupted score font cache: " << path;
+        return false;
+    }
+
+    m_symbols = std::move(symbols);
+    m_engravingDefaults = std::move(engravingDefaults);
+    m_textEnclosureThickness = textEnclosureThickness;
+
+    return true;
+}
+
+void ScoreFont::writeCache(const QString& path, const QByteArray& key) const
+{
+    CacheWriter symbolsWriter;
+    quint32 symbolsCount = 0;
+
+    for (size_t id = 0; id < m_symbols.size(); ++id) {
+        const Sym& sym = m_symbols[id];
+        if (sym.code == 0 && !sym.isCompound() && sym.smuflAnchors.empty()) {
+            continue;
+        }
+
+        symbolsWriter.write(quint32(id));
+        symbolsWriter.write(quint32(sym.code));
+        symbolsWriter.write(double(sym.bbox.x()));
+        symbolsWriter.write(double(sym.bbox.y()));
+        symbolsWriter.write(double(sym.bbox.width()));
+        symbolsWriter.write(double(sym.bbox.height()));
+        symbolsWriter.write(double(sym.advance));
+
+        symbolsWriter.write(quint8(sym.smuflAnchors.size()));
+        for (const auto& anchor : sym.smuflAnchors) {
+            symbolsWriter.write(quint8(anchor.first));
+            symbolsWriter.write(double(anchor.second.x()));
+            symbolsWriter.write(double(anchor.second.y()));
+        }
+
+        symbolsWriter.write(quint8(sym.subSymbolIds.size()));
+        for (SymId subSymbolId : sym.subSymbolIds) {
+            symbolsWriter.write(quint32(subSymbolId));
+        }
+
+        ++symbolsCount;
+    }
+
+    CacheWriter writer;
+    writer.write(symbolsCount);
+    QByteArray payload = writer.data() + symbolsWriter.data();
+
+    CacheWriter defaultsWriter;
+    quint32 defaultsCount = 0;
+    for (const auto& pair : m_engravingDefaults) {
+        if (pair.first == Sid::MusicalTextFont) {
+            continue;
+        }
+
+        defaultsWriter.write(qint32(pair.first));
+        defaultsWriter.write(pair.second.toDouble());
+        ++defaultsCount;
+    }
+    defaultsWriter.write(m_textEnclosureThickness);
+
+    CacheWriter defaultsCountWriter;
+    defaultsCountWriter.write(defaultsCount);
+    payload += defaultsCountWriter.data() + defaultsWriter.data();
+
+    writeCacheFile(path, key, payload);
+}
+
 // =============================================
 // Symbol properties
 // =============================================
@@ -28,6 +28,7 @@
 
 #include "modularity/ioc.h"
 #include "infrastructure/draw/ifontprovider.h"
+#include "iengravingconfiguration.h"
 
 #include "symid.h"
 
@@ -39,6 +40,7 @@ namespace Ms {
 class ScoreFont
 {
     INJECT_STATIC(score, mu::draw::IFontProvider, fontProvider)
+    INJECT_STATIC(score, mu::engraving::IEngravingConfiguration, engravingConfiguration)
 
 public:
     ScoreFont(const char* name, const char* family, const char* path, const char* filename);
@@ -83,6 +85,8 @@ public:
     void draw(const SymIdList&, mu::draw::Painter*, const mu::SizeF& mag, const mu::PointF& pos) const;
 
 private:
+    friend class ScoreFontTests;
+
     struct Sym {
         uint code = 0;
         mu::RectF bbox;
@@ -102,9 +106,15 @@ private:
         }
     };
 
-    static QJsonObject initGlyphNamesJson();
+    static QJsonObject initGlyphNamesJson(const QByteArray& data);
+
+    static QString cacheFilePath(const QString& fileName);
+    static bool readGlyphNamesCache(const QString& path, const QByteArray& key);
+    static void writeGlyphNamesCache(const QString& path, const QByteArray& key);
 
     void load();
+    bool readCache(const QString& path, const QByteArray& key);
+    void writeCache(const QString& path, const QByteArray& key) const;
     void loadGlyphsWithAnchors(const QJsonObject& glyphsWithAnchors);
     void loadComposedGlyphs();
     void loadStylisticAlternates(const QJsonObject& glyphsWithAlternatesObject);
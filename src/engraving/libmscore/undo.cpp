@@ -92,6 +92,11 @@
 
 #include "masterscore.h"
 
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <set>
+
 #include "log.h"
 #define LOG_UNDO() if (0) LOGD()
 
@@ -150,6 +155,34 @@ UndoCommand::~UndoCommand()
     }
 }
 
+//---------------------------------------------------------
+//   UndoCommand::newContentToken
+//    Unique random-looking value for each command
+//    (splitmix64 of a counter)
+//---------------------------------------------------------
+
+uint64_t UndoCommand::newContentToken()
+{
+    static std::atomic<uint64_t> counter { 0 };
+    uint64_t z = (++counter) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+//---------------------------------------------------------
+//   UndoCommand::contentHashToken
+//    Tokens toggled into the content hashes of the items
+//    before and after the change. Using different tokens
+//    keeps the hash changed when the same measure is
+//    touched on both sides of the change.
+//---------------------------------------------------------
+
+uint64_t UndoCommand::contentHashToken(bool afterChange) const
+{
+    return afterChange ? (contentToken ^ (contentToken >> 29)) * 0xBF58476D1CE4E5B9ULL : contentToken;
+}
+
 //---------------------------------------------------------
 //   UndoCommand::cleanup
 //---------------------------------------------------------
@@ -254,6 +287,75 @@ void UndoCommand::filterChildren(UndoCommand::Filter f, EngravingItem* target)
     childList = std::move(acceptedList);
 }
 
+//---------------------------------------------------------
+//   elementMemoryCost
+///   Rough estimate of the memory held by \p e and its
+///   children. Only used to bound the undo history, so it
+///   does not need to be exact.
+//---------------------------------------------------------
+
+static size_t elementMemoryCost(const EngravingObject* e)
+{
+    static constexpr size_t ELEMENT_COST = 512;
+
+    if (!e) {
+        return 0;
+    }
+    size_t cost = ELEMENT_COST;
+    for (const EngravingObject* child : e->children()) {
+        cost += elementMemoryCost(child);
+    }
+    return cost;
+}
+
+//---------------------------------------------------------
+//   memoryCost
+///   Approximate number of bytes this command keeps alive.
+//---------------------------------------------------------
+
+size_t UndoCommand::memoryCost() const
+{
+    size_t cost = sizeof(*this);
+    for (const UndoCommand* c : childList) {
+        cost += c->memoryCost();
+    }
+    return cost;
+}
+
+//---------------------------------------------------------
+//   mergePropertyChanges
+///   Drop property changes which directly follow a change
+///   of the same property of the same element. ChangeProperty
+///   stores the value it replaces, so the first command of
+///   such a run restores the original value on undo and
+///   picks up the final value for redo by itself.
+//---------------------------------------------------------
+
+void UndoCommand::mergePropertyChanges()
+{
+    if (childList.size() < 2) {
+        return;
+    }
+
+    QList<UndoCommand*> mergedList;
+    const ChangeProperty* last = nullptr;
+    for (UndoCommand* cmd : qAsConst(childList)) {
+        if (strcmp(cmd->name(), "ChangeProperty") != 0) {
+            mergedList.push_back(cmd);
+            last = nullptr;
+            continue;
+        }
+        const ChangeProperty* cp = static_cast<const ChangeProperty*>(cmd);
+        if (last && last->getElement() == cp->getElement() && last->getId() == cp->getId()) {
+            delete cmd;
+            continue;
+        }
+        mergedList.push_back(cmd);
+        last = cp;
+    }
+    childList = std::move(mergedList);
+}
+
 //---------------------------------------------------------
 //   unwind
 //---------------------------------------------------------
@@ -319,7 +421,9 @@ void UndoStack::push(UndoCommand* cmd, EditData* ed)
             LOG_UNDO() << "no active command, UndoStack";
         }
 
+        toggleContentHash(cmd, false);
         cmd->redo(ed);
+        toggleContentHash(cmd, true);
         delete cmd;
         return;
     }
@@ -332,7 +436,9 @@ void UndoStack::push(UndoCommand* cmd, EditData* ed)
     }
 #endif
     curCmd->appendChild(cmd);
+    toggleContentHash(cmd, false);
     cmd->redo(ed);
+    toggleContentHash(cmd, true);
 }
 
 //---------------------------------------------------------
@@ -348,6 +454,8 @@ void UndoStack::push1(UndoCommand* cmd)
         return;
     }
     curCmd->appendChild(cmd);
+    // the command has been applied already
+    toggleContentHash(cmd, true);
 }
 
 //---------------------------------------------------------
@@ -381,6 +489,8 @@ void UndoStack::remove(int idx)
 
 void UndoStack::mergeCommands(int startIdx)
 {
+    // startIdx comes from getCurIdx(), the steps dropped since then are merged already
+    startIdx = std::max(startIdx - baseIdx, 0);
     Q_ASSERT(startIdx <= curIdx);
 
     if (startIdx >= list.size()) {
@@ -393,6 +503,242 @@ void UndoStack::mergeCommands(int startIdx)
         startMacro->append(std::move(*list[idx]));
     }
     remove(startIdx + 1);   // TODO: remove from startIdx to curIdx only
+    startMacro->updateMemoryCost();
+}
+
+//---------------------------------------------------------
+//   memoryCost
+//---------------------------------------------------------
+
+size_t UndoStack::memoryCost() const
+{
+    size_t cost = 0;
+    for (const UndoMacro* m : list) {
+        cost += m->memoryCost();
+    }
+    return cost;
+}
+
+//---------------------------------------------------------
+//   affectsOtherMeasures
+//    Items that can change how other measures are played
+//    or laid out: tempo, dynamics, repeats, measure
+//    lengths, instrument or key changes...
+//---------------------------------------------------------
+
+static bool affectsOtherMeasures(const EngravingItem* e)
+{
+    switch (e->type()) {
+    case ElementType::MEASURE:
+    case ElementType::BAR_LINE:
+    case ElementType::CLEF:
+    case ElementType::KEYSIG:
+    case ElementType::TIMESIG:
+    case ElementType::BREATH:
+    case ElementType::FERMATA:
+    case ElementType::DYNAMIC:
+    case ElementType::HAIRPIN:
+    case ElementType::MARKER:
+    case ElementType::JUMP:
+    case ElementType::VOLTA:
+    case ElementType::TEMPO_TEXT:
+    case ElementType::STAFF_TEXT:
+    case ElementType::SYSTEM_TEXT:
+    case ElementType::INSTRUMENT_CHANGE:
+    case ElementType::HARMONY:
+        return true;
+    default:
+        return false;
+    }
+}
+
+//---------------------------------------------------------
+//   addContentTargets
+//    Collects measure staves whose content depends on the
+//    item. Staff index -1 stands for all staves of the
+//    measure. Sets global if the item can't be attributed
+//    to particular measures.
+//---------------------------------------------------------
+
+using ContentTargets = std::set<std::pair<Measure*, int> >;
+
+static void addContentTargets(const EngravingObject* o, ContentTargets& targets, bool& global)
+{
+    if (!o || !o->isEngravingItem()) {
+        global = true;
+        return;
+    }
+
+    const EngravingItem* e = toEngravingItem(o);
+    if (e->isSpannerSegment()) {
+        e = toSpannerSegment(e)->spanner();
+    }
+    if (!e || affectsOtherMeasures(e)) {
+        global = true;
+        return;
+    }
+
+    if (e->isSpanner()) {
+        const Spanner* sp = toSpanner(e);
+        Measure* m = sp->score()->tick2measure(sp->tick());
+        if (!m) {
+            global = true;
+            return;
+        }
+        const int staff2 = sp->track2() >= 0 ? sp->track2() / VOICES : sp->staffIdx();
+        for (; m && m->tick() <= sp->tick2(); m = m->nextMeasure()) {
+            targets.insert({ m, sp->staffIdx() });
+            targets.insert({ m, staff2 });
+        }
+        return;
+    }
+
+    // multimeasure rests are made by the layout and may be gone
+    // by the time the step is undone, they can't keep a hash
+    Measure* m = const_cast<EngravingItem*>(e)->findMeasure();
+    if (!m || m->isMMRest()) {
+        global = true;
+        return;
+    }
+    targets.insert({ m, e->isSegment() ? -1 : e->staffIdx() });
+}
+
+//---------------------------------------------------------
+//   collectContentTargets
+//---------------------------------------------------------
+
+static void collectContentTargets(const UndoCommand* cmd, ContentTargets& targets, bool& global)
+{
+    const std::vector<const EngravingObject*> items = cmd->objectItems();
+    if (items.empty()) {
+        global = true;
+    }
+    for (const EngravingObject* o : items) {
+        addContentTargets(o, targets, global);
+    }
+    for (const UndoCommand* child : cmd->commands()) {
+        if (global) {
+            return;
+        }
+        collectContentTargets(child, targets, global);
+    }
+}
+
+//---------------------------------------------------------
+//   toggleContentHash
+//    Toggles the command's token in the content hashes of
+//    the measure staves it touches. Called before and after
+//    each application of a command, so that the hashes
+//    change on edits. The toggles are kept in the current
+//    macro, undoing and redoing it toggles the same tokens
+//    in the same measure staves again, which gives back
+//    the hashes from before and after the edit exactly.
+//    If the command can't be attributed to measures the
+//    global hash, which is part of every measure's hash,
+//    is toggled instead.
+//---------------------------------------------------------
+
+void UndoStack::toggleContentHash(const UndoCommand* cmd, bool afterChange)
+{
+    ContentTargets targets;
+    bool global = false;
+    collectContentTargets(cmd, targets, global);
+
+    ContentHashToggle toggle;
+    toggle.token = cmd->contentHashToken(afterChange);
+    if (!global) {
+        // Each staff must get the token once, or it would cancel out.
+        // Targets are sorted, so an all staves target (-1) comes first.
+        const Measure* allStaves = nullptr;
+        for (const auto& target : targets) {
+            if (target.first == allStaves) {
+                continue;
+            }
+            if (!target.first->toggleContentHash(target.second, toggle.token)) {
+                // revert, the global hash accounts for everything
+                for (const auto& done : toggle.staves) {
+                    done.first->toggleContentHash(done.second, toggle.token);
+                }
+                toggle.staves.clear();
+                global = true;
+                break;
+            }
+            toggle.staves.push_back(target);
+            if (target.second < 0) {
+                allStaves = target.first;
+            }
+        }
+    }
+    if (global) {
+        globalHash ^= toggle.token;
+        toggle.global = true;
+    }
+    ++contentChanges;
+
+    if (curCmd) {
+        curCmd->addContentHashToggle(std::move(toggle));
+    }
+}
+
+void UndoStack::toggleContentHash(const ContentHashToggle& toggle)
+{
+    for (const auto& target : toggle.staves) {
+        target.first->toggleContentHash(target.second, toggle.token);
+    }
+    if (toggle.global) {
+        globalHash ^= toggle.token;
+    }
+    ++contentChanges;
+}
+
+//---------------------------------------------------------
+//   toggleContentHashes
+//    Toggles again everything the macro's commands toggled
+//    when they were pushed: called when the macro is undone,
+//    redone or unwound.
+//---------------------------------------------------------
+
+void UndoStack::toggleContentHashes(const UndoMacro* macro)
+{
+    for (const ContentHashToggle& toggle : macro->contentHashes()) {
+        toggleContentHash(toggle);
+    }
+}
+
+//---------------------------------------------------------
+//   removeOldest
+///   Forget the oldest undo step.
+//---------------------------------------------------------
+
+void UndoStack::removeOldest()
+{
+    Q_ASSERT(curIdx > 0);
+    UndoCommand* cmd = list.takeFirst();
+    stateList.erase(stateList.begin());
+    cmd->cleanup(true);
+    delete cmd;
+    --curIdx;
+    ++baseIdx;
+}
+
+//---------------------------------------------------------
+//   applyMemoryBudget
+///   Drop the oldest undo steps until the history fits into
+///   MScore::undoMemoryBudget. The most recent step is always
+///   kept, so that the last edit can be undone.
+//---------------------------------------------------------
+
+void UndoStack::applyMemoryBudget()
+{
+    if (MScore::undoMemoryBudget == 0) {
+        return;
+    }
+
+    size_t cost = memoryCost();
+    while (cost > MScore::undoMemoryBudget && curIdx > 1) {
+        cost -= list.first()->memoryCost();
+        removeOldest();
+    }
 }
 
 //---------------------------------------------------------
@@ -445,9 +791,12 @@ void UndoStack::endMacro(bool rollback)
             cmd->cleanup(false);        // delete elements for which UndoCommand() holds ownership
             delete cmd;
         }
+        curCmd->mergePropertyChanges();
+        curCmd->updateMemoryCost();
         list.append(curCmd);
         stateList.push_back(nextState++);
         ++curIdx;
+        applyMemoryBudget();
     }
     curCmd = 0;
 }
@@ -488,7 +837,7 @@ void UndoStack::undo(EditData* ed)
     // Are we currently editing text?
     if (ed && ed->element && ed->element->isTextBase()) {
         TextEditData* ted = static_cast<TextEditData*>(ed->getData(ed->element));
-        if (ted && ted->startUndoIdx == curIdx) {
+        if (ted && ted->startUndoIdx == getCurIdx()) {
             // No edits to undo, so do nothing
             return;
         }
@@ -496,7 +845,9 @@ void UndoStack::undo(EditData* ed)
     if (curIdx) {
         --curIdx;
         Q_ASSERT(curIdx >= 0);
-        list[curIdx]->undo(ed);
+        UndoMacro* macro = list[curIdx];
+        macro->undo(ed);
+        toggleContentHashes(macro);
     }
 }
 
@@ -508,7 +859,9 @@ void UndoStack::redo(EditData* ed)
 {
     LOG_UNDO() << "called";
     if (canRedo()) {
-        list[curIdx++]->redo(ed);
+        UndoMacro* macro = list[curIdx++];
+        macro->redo(ed);
+        toggleContentHashes(macro);
     }
 }
 
@@ -593,15 +946,33 @@ void UndoMacro::redo(EditData* ed)
     }
 }
 
+void UndoMacro::unwind()
+{
+    UndoCommand::unwind();
+    score->undoStack()->toggleContentHashes(this);
+    contentHashToggles.clear();
+}
+
 void UndoMacro::append(UndoMacro&& other)
 {
     appendChildren(&other);
+    std::move(other.contentHashToggles.begin(), other.contentHashToggles.end(), std::back_inserter(contentHashToggles));
+    other.contentHashToggles.clear();
     if (score == other.score) {
         redoInputState = std::move(other.redoInputState);
         redoSelectionInfo = std::move(other.redoSelectionInfo);
     }
 }
 
+//---------------------------------------------------------
+//   updateMemoryCost
+//---------------------------------------------------------
+
+void UndoMacro::updateMemoryCost()
+{
+    cachedMemoryCost = UndoCommand::memoryCost();
+}
+
 //---------------------------------------------------------
 //   CloneVoice
 //---------------------------------------------------------
@@ -823,6 +1194,15 @@ const char* AddElement::name() const
     return buffer;
 }
 
+//---------------------------------------------------------
+//   AddElement::memoryCost
+//---------------------------------------------------------
+
+size_t AddElement::memoryCost() const
+{
+    return sizeof(*this) + elementMemoryCost(element);
+}
+
 //---------------------------------------------------------
 //   AddElement::isFiltered
 //---------------------------------------------------------
@@ -975,6 +1355,15 @@ const char* RemoveElement::name() const
     return buffer;
 }
 
+//---------------------------------------------------------
+//   RemoveElement::memoryCost
+//---------------------------------------------------------
+
+size_t RemoveElement::memoryCost() const
+{
+    return sizeof(*this) + elementMemoryCost(element);
+}
+
 //---------------------------------------------------------
 //   RemoveElement::isFiltered
 //---------------------------------------------------------
@@ -1942,6 +2331,22 @@ std::vector<Clef*> InsertRemoveMeasures::getCourtesyClefs(Measure* m)
     return startClefs;
 }
 
+//---------------------------------------------------------
+//   InsertRemoveMeasures::memoryCost
+//---------------------------------------------------------
+
+size_t InsertRemoveMeasures::memoryCost() const
+{
+    size_t cost = sizeof(*this);
+    for (MeasureBase* m = fm; m; m = m->next()) {
+        cost += elementMemoryCost(m);
+        if (m == lm) {
+            break;
+        }
+    }
+    return cost;
+}
+
 //---------------------------------------------------------
 //   insertMeasures
 //---------------------------------------------------------
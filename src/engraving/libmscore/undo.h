@@ -102,6 +102,9 @@ class EditData;
 class UndoCommand
 {
     QList<UndoCommand*> childList;
+    uint64_t contentToken = newContentToken();
+
+    static uint64_t newContentToken();
 
 protected:
     virtual void flip(EditData*) {}
@@ -124,7 +127,7 @@ public:
     void appendChild(UndoCommand* cmd) { childList.append(cmd); }
     UndoCommand* removeChild() { return childList.takeLast(); }
     int childCount() const { return childList.size(); }
-    void unwind();
+    virtual void unwind();
     const QList<UndoCommand*>& commands() const { return childList; }
     virtual void cleanup(bool undo);
 // #ifndef QT_NO_DEBUG
@@ -135,6 +138,27 @@ public:
     bool hasFilteredChildren(Filter, const EngravingItem* target) const;
     bool hasUnfilteredChildren(const std::vector<Filter>& filters, const EngravingItem* target) const;
     void filterChildren(UndoCommand::Filter f, EngravingItem* target);
+
+    virtual size_t memoryCost() const;
+    void mergePropertyChanges();
+
+    // Items changed by this command (not including its children). Empty if
+    // the command may change anything, e.g. staves, parts or style.
+    virtual std::vector<const EngravingObject*> objectItems() const { return {}; }
+    uint64_t contentHashToken(bool afterChange) const;
+};
+
+//---------------------------------------------------------
+//   ContentHashToggle
+//    A token toggled into the content hashes of measure
+//    staves (staff index -1 for all staves of a measure),
+//    or into the global hash
+//---------------------------------------------------------
+
+struct ContentHashToggle {
+    uint64_t token = 0;
+    std::vector<std::pair<Measure*, int> > staves;
+    bool global = false;
 };
 
 //---------------------------------------------------------
@@ -165,13 +189,26 @@ class UndoMacro : public UndoCommand
     static void fillSelectionInfo(SelectionInfo&, const Selection&);
     static void applySelectionInfo(const SelectionInfo&, Selection&);
 
+    size_t cachedMemoryCost = 0;
+
+    // toggled by the commands when they were pushed,
+    // undo and redo toggle exactly the same again
+    std::vector<ContentHashToggle> contentHashToggles;
+
 public:
     UndoMacro(Score* s);
     virtual void undo(EditData*) override;
     virtual void redo(EditData*) override;
+    void unwind() override;
     bool empty() const { return childCount() == 0; }
     void append(UndoMacro&& other);
 
+    void addContentHashToggle(ContentHashToggle&& toggle) { contentHashToggles.push_back(std::move(toggle)); }
+    const std::vector<ContentHashToggle>& contentHashes() const { return contentHashToggles; }
+
+    size_t memoryCost() const override { return cachedMemoryCost; }
+    void updateMemoryCost();
+
     static bool canRecordSelectedElement(const EngravingItem* e);
 
     UNDO_NAME("UndoMacro");
@@ -189,8 +226,16 @@ class UndoStack
     int nextState;
     int cleanState;
     int curIdx;
+    int baseIdx = 0;    // number of the oldest steps dropped by applyMemoryBudget()
+
+    uint64_t globalHash = 0;
+    uint64_t contentChanges = 0;
 
     void remove(int idx);
+    void removeOldest();
+    void applyMemoryBudget();
+    void toggleContentHash(const UndoCommand*, bool afterChange);
+    void toggleContentHash(const ContentHashToggle&);
 
 public:
     UndoStack();
@@ -207,7 +252,7 @@ public:
     bool canRedo() const { return curIdx < list.size(); }
     int state() const { return stateList[curIdx]; }
     bool isClean() const { return cleanState == state(); }
-    int getCurIdx() const { return curIdx; }
+    int getCurIdx() const { return baseIdx + curIdx; }   // stays valid when the oldest steps are dropped
     bool empty() const { return !canUndo() && !canRedo(); }
     UndoMacro* current() const { return curCmd; }
     UndoMacro* last() const { return curIdx > 0 ? list[curIdx - 1] : 0; }
@@ -219,6 +264,13 @@ public:
 
     void mergeCommands(int startIdx);
     void cleanRedoStack() { remove(curIdx); }
+
+    size_t memoryCost() const;
+    int size() const { return list.size(); }
+
+    uint64_t globalContentHash() const { return globalHash; }
+    uint64_t contentChangesCount() const { return contentChanges; }   // changes by undoable commands so far
+    void toggleContentHashes(const UndoMacro*);                         // undoes or redoes the macro's hash changes
 };
 
 //---------------------------------------------------------
@@ -418,6 +470,7 @@ class ChangePitch : public UndoCommand
 public:
     ChangePitch(Note* note, int pitch, int tpc1, int tpc2);
     UNDO_NAME("ChangePitch")
+    std::vector<const EngravingObject*> objectItems() const override { return { note }; }
 };
 
 //---------------------------------------------------------
@@ -437,6 +490,7 @@ class ChangeFretting : public UndoCommand
 public:
     ChangeFretting(Note* note, int pitch, int string, int fret, int tpc1, int tpc2);
     UNDO_NAME("ChangeFretting")
+    std::vector<const EngravingObject*> objectItems() const override { return { note }; }
 };
 
 //---------------------------------------------------------
@@ -485,6 +539,7 @@ class ChangeElement : public UndoCommand
 public:
     ChangeElement(EngravingItem* oldElement, EngravingItem* newElement);
     UNDO_NAME("ChangeElement")
+    std::vector<const EngravingObject*> objectItems() const override { return { oldElement, newElement }; }
 };
 
 //---------------------------------------------------------
@@ -605,6 +660,8 @@ public:
     EngravingItem* getElement() const { return element; }
     virtual void cleanup(bool) override;
     virtual const char* name() const override;
+    size_t memoryCost() const override;
+    std::vector<const EngravingObject*> objectItems() const override { return { element }; }
 
     bool isFiltered(UndoCommand::Filter f, const EngravingItem* target) const override;
 };
@@ -623,6 +680,8 @@ public:
     virtual void redo(EditData*) override;
     virtual void cleanup(bool) override;
     virtual const char* name() const override;
+    size_t memoryCost() const override;
+    std::vector<const EngravingObject*> objectItems() const override { return { element }; }
 
     bool isFiltered(UndoCommand::Filter f, const EngravingItem* target) const override;
 };
@@ -645,6 +704,7 @@ public:
     virtual void undo(EditData*) override;
     virtual void redo(EditData*) override;
     UNDO_NAME("EditText")
+    std::vector<const EngravingObject*> objectItems() const override { return { text }; }
 };
 
 //---------------------------------------------------------
@@ -808,6 +868,7 @@ class ChangeChordStaffMove : public UndoCommand
 public:
     ChangeChordStaffMove(ChordRest* cr, int);
     UNDO_NAME("ChangeChordStaffMove")
+    std::vector<const EngravingObject*> objectItems() const override { return { chordRest }; }
 };
 
 //---------------------------------------------------------
@@ -824,6 +885,7 @@ class ChangeVelocity : public UndoCommand
 public:
     ChangeVelocity(Note*, VeloType, int);
     UNDO_NAME("ChangeVelocity")
+    std::vector<const EngravingObject*> objectItems() const override { return { note }; }
 };
 
 //---------------------------------------------------------
@@ -861,6 +923,7 @@ protected:
 public:
     InsertRemoveMeasures(MeasureBase* _fm, MeasureBase* _lm)
         : fm(_fm), lm(_lm) {}
+    size_t memoryCost() const override;
     virtual void undo(EditData*) override = 0;
     virtual void redo(EditData*) override = 0;
 };
@@ -1027,6 +1090,7 @@ public:
     ChangeNoteEventList(Ms::Note* n, NoteEventList& ne)
         : note(n), newEvents(ne), newPetype(PlayEventType::User) {}
     UNDO_NAME("ChangeNoteEventList")
+    std::vector<const EngravingObject*> objectItems() const override { return { note }; }
 };
 
 //---------------------------------------------------------
@@ -1049,6 +1113,7 @@ public:
     }
 
     UNDO_NAME("ChangeChordPlayEventType")
+    std::vector<const EngravingObject*> objectItems() const override { return { chord }; }
 };
 
 //---------------------------------------------------------
@@ -1125,6 +1190,7 @@ public:
     EngravingObject* getElement() const { return element; }
     mu::engraving::PropertyValue data() const { return property; }
     UNDO_NAME("ChangeProperty")
+    std::vector<const EngravingObject*> objectItems() const override { return { element }; }
 
     bool isFiltered(UndoCommand::Filter f, const EngravingItem* target) const override
     {
@@ -93,6 +93,11 @@ void PaintDebugger::setCompositionMode(CompositionMode mode)
     m_real->setCompositionMode(mode);
 }
 
+void PaintDebugger::setSymbolsCacheEnabled(bool arg)
+{
+    m_real->setSymbolsCacheEnabled(arg);
+}
+
 void PaintDebugger::setFont(const Font& f)
 {
     m_real->setFont(f);
@@ -44,6 +44,7 @@ public:
 
     void setAntialiasing(bool arg) override;
     void setCompositionMode(draw::CompositionMode mode) override;
+    void setSymbolsCacheEnabled(bool arg) override;
 
     void setFont(const draw::Font& font) override;
     const draw::Font& font() const override;
@@ -23,6 +23,7 @@
 #ifndef MU_ENGRAVING_FRACTION_H
 #define MU_ENGRAVING_FRACTION_H
 
+#include <array>
 #include <cstdint>
 
 #include <QString>
@@ -56,6 +57,38 @@ inline int_least64_t gcd(int_least64_t a, int_least64_t b)
     return a >= 0 ? a : -a;
 }
 
+//---------------------------------------------------------
+//   tickGridGcd
+//    gcd(ticks, Constants::division * 4) by table lookup.
+//    Every fromTicks() reduces against the same whole-note
+//    grid, so the Euclid loop is precomputed once per remainder
+//---------------------------------------------------------
+
+namespace detail {
+constexpr int TICKS_PER_WHOLE = Constants::division * 4;
+
+inline constexpr std::array<uint16_t, TICKS_PER_WHOLE> TICK_GRID_GCD = [] {
+    std::array<uint16_t, TICKS_PER_WHOLE> table {};
+    for (int r = 0; r < TICKS_PER_WHOLE; ++r) {
+        int a = TICKS_PER_WHOLE;
+        int b = r;
+        while (b != 0) {
+            const int t = a % b;
+            a = b;
+            b = t;
+        }
+        table[r] = static_cast<uint16_t>(a);
+    }
+    return table;
+}();
+}
+
+inline int tickGridGcd(int ticks)
+{
+    const int r = ticks % detail::TICKS_PER_WHOLE;
+    return detail::TICK_GRID_GCD[r >= 0 ? r : -r];
+}
+
 class Fraction
 {
     // ensure 64 bit to avoid overflows in comparisons
@@ -121,6 +154,13 @@ public:
 
     void reduce()
     {
+        if (m_denominator == 1) {
+            return;
+        }
+        if (m_numerator == 0 && m_denominator != 0) {
+            m_denominator = 1;
+            return;
+        }
         const int g = gcd(m_numerator, m_denominator);
         m_numerator /= g;
         m_denominator /= g;
@@ -128,6 +168,9 @@ public:
 
     Fraction reduced() const
     {
+        if (m_denominator == 1) {
+            return *this;
+        }
         const int g = gcd(m_numerator, m_denominator);
         return Fraction(m_numerator / g, m_denominator / g);
     }
@@ -170,6 +213,12 @@ public:
     {
         if (m_denominator == val.m_denominator) {
             m_numerator += val.m_numerator;        // Common enough use case to be handled separately for efficiency
+        } else if (m_denominator != 0 && val.m_denominator % m_denominator == 0) {
+            // one grid is a subdivision of the other (e.g. 1/4 and 1/16): the lcm is the finer one
+            m_numerator = m_numerator * (val.m_denominator / m_denominator) + val.m_numerator;
+            m_denominator = val.m_denominator;
+        } else if (m_denominator % val.m_denominator == 0) {
+            m_numerator += val.m_numerator * (m_denominator / val.m_denominator);
         } else {
             const int g = gcd(m_denominator, val.m_denominator);
             const int m1 = val.m_denominator / g;       // This saves one division over straight lcm
@@ -183,6 +232,12 @@ public:
     {
         if (m_denominator == val.m_denominator) {
             m_numerator -= val.m_numerator;       // Common enough use case to be handled separately for efficiency
+        } else if (m_denominator != 0 && val.m_denominator % m_denominator == 0) {
+            // one grid is a subdivision of the other (e.g. 1/4 and 1/16): the lcm is the finer one
+            m_numerator = m_numerator * (val.m_denominator / m_denominator) - val.m_numerator;
+            m_denominator = val.m_denominator;
+        } else if (m_denominator % val.m_denominator == 0) {
+            m_numerator -= val.m_numerator * (m_denominator / val.m_denominator);
         } else {
             const int g = gcd(m_denominator, val.m_denominator);
             const int m1 = val.m_denominator / g;       // This saves one division over straight lcm
@@ -258,7 +313,8 @@ public:
         if (ticks == -1) {
             return Fraction(-1, 1);        // HACK
         }
-        return Fraction(ticks, Constants::division * 4).reduced();
+        const int g = tickGridGcd(ticks);
+        return Fraction(ticks / g, detail::TICKS_PER_WHOLE / g);
     }
 
     // A very small fraction, corresponds to 1 MIDI tick
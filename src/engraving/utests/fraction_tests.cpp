@@ -0,0 +1,93 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "engraving/types/fraction.h"
+
+using namespace mu::engraving;
+
+class FractionTests : public ::testing::Test
+{
+};
+
+//! NOTE Reference results computed the slow way, without any of the fast paths
+static Fraction referenceReduced(int z, int n)
+{
+    const int g = gcd(z, n);
+    return Fraction(z / g, n / g);
+}
+
+TEST_F(FractionTests, fromTicks)
+{
+    for (int ticks = -4 * Constants::division * 4; ticks <= 4 * Constants::division * 4; ++ticks) {
+        if (ticks == -1) {
+            continue;
+        }
+        const Fraction f = Fraction::fromTicks(ticks);
+        EXPECT_TRUE(f.identical(referenceReduced(ticks, Constants::division * 4))) << ticks;
+        EXPECT_EQ(f.ticks(), ticks);
+    }
+
+    EXPECT_TRUE(Fraction::fromTicks(-1).identical(Fraction(-1, 1)));
+    EXPECT_TRUE(Fraction::fromTicks(0).identical(Fraction(0, 1)));
+    EXPECT_TRUE(Fraction::fromTicks(Constants::division).identical(Fraction(1, 4)));
+}
+
+TEST_F(FractionTests, addSubtract)
+{
+    for (int d1 = 1; d1 <= 64; ++d1) {
+        for (int d2 = 1; d2 <= 64; ++d2) {
+            for (int n1 = -3; n1 <= 3; ++n1) {
+                for (int n2 = -3; n2 <= 3; ++n2) {
+                    const Fraction a(n1, d1);
+                    const Fraction b(n2, d2);
+
+                    // the result keeps the lcm of both denominators, as without the fast paths
+                    const int l = d1 / gcd(d1, d2) * d2;
+                    const Fraction sum = a + b;
+                    EXPECT_TRUE(sum.identical(Fraction(n1 * (l / d1) + n2 * (l / d2), l)));
+                    const Fraction diff = a - b;
+                    EXPECT_TRUE(diff.identical(Fraction(n1 * (l / d1) - n2 * (l / d2), l)));
+                }
+            }
+        }
+    }
+}
+
+TEST_F(FractionTests, reduce)
+{
+    Fraction f(0, 16);
+    f.reduce();
+    EXPECT_TRUE(f.identical(Fraction(0, 1)));
+
+    f = Fraction(6, 1);
+    f.reduce();
+    EXPECT_TRUE(f.identical(Fraction(6, 1)));
+
+    f = Fraction(-12, 16);
+    f.reduce();
+    EXPECT_TRUE(f.identical(Fraction(-3, 4)));
+
+    EXPECT_TRUE(Fraction(5, 1).reduced().identical(Fraction(5, 1)));
+    EXPECT_TRUE(Fraction(30, 120).reduced().identical(Fraction(1, 4)));
+}
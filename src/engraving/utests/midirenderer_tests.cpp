@@ -0,0 +1,197 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+
+#include "compat/midi/event.h"
+#include "libmscore/chord.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/note.h"
+#include "libmscore/rendermidi.h"
+#include "libmscore/segment.h"
+#include "libmscore/undo.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu::engraving;
+using namespace Ms;
+
+static const QString MIDIRENDERER_DATA_DIR("midirenderer_data/");
+
+class MidiRendererTests : public ::testing::Test
+{
+};
+
+static EventMap renderEvents(MidiRenderer& renderer, Score* score, bool concurrently = false)
+{
+    EventMap events;
+    MidiRenderer::Context ctx;
+    ctx.metronome = false;
+    ctx.renderHarmony = true;
+    ctx.renderStavesConcurrently = concurrently;
+
+    for (const MidiRenderer::Chunk& chunk : renderer.chunksFromRange(0, score->lastMeasure()->endTick().ticks())) {
+        renderer.renderChunk(chunk, &events, ctx);
+    }
+
+    return events;
+}
+
+static std::vector<int> noteOnPitches(const EventMap& events)
+{
+    std::vector<int> pitches;
+    for (const auto& event : events) {
+        if (event.second.type() == ME_NOTEON && event.second.velo() > 0) {
+            pitches.push_back(event.second.pitch());
+        }
+    }
+    return pitches;
+}
+
+//---------------------------------------------------------
+//    rendered measure events are reused until the measures
+//    are changed by undoable edits
+//---------------------------------------------------------
+
+TEST_F(MidiRendererTests, measureEventsCache)
+{
+    MasterScore* score = ScoreRW::readScore("test.mscx");
+    ASSERT_TRUE(score);
+
+    Segment* s = score->firstMeasure()->first(SegmentType::ChordRest);
+    ASSERT_TRUE(s && s->element(0) && s->element(0)->isChord());
+    Note* note = toChord(s->element(0))->upNote();
+    ASSERT_EQ(note->pitch(), 60);
+
+    MidiRenderer renderer(score);
+
+    const std::vector<int> pitches = noteOnPitches(renderEvents(renderer, score));
+    ASSERT_FALSE(pitches.empty());
+    EXPECT_EQ(pitches.front(), 60);
+
+    //! NOTE Changes bypassing the undo stack must be reported, they can't be attributed to measures
+    note->setPitch(72);
+    renderer.setContentChanged();
+    EXPECT_EQ(noteOnPitches(renderEvents(renderer, score)).front(), 72);
+    note->setPitch(60);
+    renderer.setContentChanged();
+    EXPECT_EQ(noteOnPitches(renderEvents(renderer, score)), pitches);
+
+    score->startCmd();
+    score->undo(new ChangePitch(note, 62, note->tpc1(), note->tpc2()));
+    score->endCmd();
+
+    std::vector<int> edited = noteOnPitches(renderEvents(renderer, score));
+    ASSERT_EQ(edited.size(), pitches.size());
+    EXPECT_EQ(edited.front(), 62);
+    EXPECT_TRUE(std::equal(edited.begin() + 1, edited.end(), pitches.begin() + 1));
+
+    EditData ed;
+    score->undoStack()->undo(&ed);
+    EXPECT_EQ(noteOnPitches(renderEvents(renderer, score)), pitches);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//    rendering the staves concurrently gives exactly
+//    the events of the serial rendering, in the same order
+//---------------------------------------------------------
+
+TEST_F(MidiRendererTests, concurrentStaves)
+{
+    for (const char* name : { "testKantataBWV140Excerpts", "testMeasureRepeats", "testGlissandoAcrossStaffs",
+                              "testRepeatsDynamics", "testPedal" }) {
+        MasterScore* score = ScoreRW::readScore(MIDIRENDERER_DATA_DIR + name + ".mscx");
+        ASSERT_TRUE(score) << name;
+
+        MidiRenderer serialRenderer(score);
+        const EventMap serial = renderEvents(serialRenderer, score);
+
+        MidiRenderer concurrentRenderer(score);
+        const EventMap concurrent = renderEvents(concurrentRenderer, score, true);
+
+        ASSERT_EQ(concurrent.size(), serial.size()) << name;
+        EXPECT_EQ(concurrent.highestChannel(), serial.highestChannel()) << name;
+
+        auto it = concurrent.cbegin();
+        for (const auto& event : serial) {
+            EXPECT_EQ(it->first, event.first) << name;
+            EXPECT_TRUE(it->second == event.second) << name << " at tick " << event.first;
+            EXPECT_EQ(it->second.getOriginatingStaff(), event.second.getOriginatingStaff()) << name;
+            ++it;
+        }
+
+        delete score;
+    }
+}
+
+//---------------------------------------------------------
+//    events with equal ticks keep their insertion order,
+//    also when inserting after the map was read
+//---------------------------------------------------------
+
+TEST_F(MidiRendererTests, eventMapOrder)
+{
+    auto event = [](int pitch) {
+        return NPlayEvent(ME_NOTEON, 0, pitch, 80);
+    };
+
+    EventMap events;
+    std::multimap<int, int> expected;
+    auto insert = [&](int tick, int pitch) {
+        events.insert(std::make_pair(tick, event(pitch)));
+        expected.insert({ tick, pitch });
+    };
+
+    insert(480, 1);
+    insert(0, 2);
+    insert(480, 3);
+    insert(240, 4);
+    EXPECT_EQ(events.begin()->second.pitch(), 2);
+
+    insert(480, 5);
+    insert(0, 6);
+    insert(960, 7);
+    insert(480, 8);
+
+    ASSERT_EQ(events.size(), expected.size());
+    auto it = expected.cbegin();
+    for (const auto& e : events) {
+        EXPECT_EQ(e.first, it->first);
+        EXPECT_EQ(e.second.pitch(), it->second);
+        ++it;
+    }
+
+    auto range = events.equal_range(480);
+    ASSERT_EQ(std::distance(range.first, range.second), 4);
+    EXPECT_EQ(range.first->second.pitch(), 1);
+    EXPECT_EQ((range.second - 1)->second.pitch(), 8);
+
+    events.erase(range.first, range.second);
+    EXPECT_EQ(events.size(), 4u);
+    EXPECT_EQ(events.lower_bound(480)->first, 960);
+}
@@ -0,0 +1,157 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <QElapsedTimer>
+#include <QImage>
+
+#include "infrastructure/draw/painter.h"
+#include "libmscore/scorefont.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::draw;
+using namespace Ms;
+
+static const std::vector<SymId> SYMBOLS = {
+    SymId::noteheadBlack, SymId::noteheadHalf, SymId::accidentalSharp, SymId::accidentalFlat,
+    SymId::restQuarter, SymId::flag8thUp, SymId::gClef, SymId::fClef
+};
+
+static constexpr int IMAGE_WIDTH = 1200;
+static constexpr int IMAGE_HEIGHT = 800;
+
+class PaintTests : public ::testing::Test
+{
+public:
+    //! NOTE Roughly what a page of a score looks like to the painter: many small symbols at arbitrary positions
+    static void paintSymbols(QImage& image, qreal zoom, bool cacheEnabled)
+    {
+        image.fill(Qt::white);
+
+        Painter painter(&image, "paint_tests");
+        painter.setAntialiasing(true);
+        painter.setSymbolsCacheEnabled(cacheEnabled);
+        painter.scale(zoom, zoom);
+
+        const ScoreFont* font = ScoreFont::fallbackFont();
+        const qreal width = IMAGE_WIDTH / zoom;
+        const qreal height = IMAGE_HEIGHT / zoom;
+
+        int i = 0;
+        for (qreal y = 40.0; y < height - 40.0; y += 23.7) {
+            for (qreal x = 20.0; x < width - 40.0; x += 17.3) {
+                font->draw(SYMBOLS.at(i % SYMBOLS.size()), &painter, 1.0, PointF(x, y));
+                ++i;
+            }
+        }
+
+        painter.endDraw();
+    }
+
+    static double ink(const QImage& image)
+    {
+        double sum = 0.0;
+        for (int y = 0; y < image.height(); ++y) {
+            const QRgb* line = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+            for (int x = 0; x < image.width(); ++x) {
+                sum += 255 - qGray(line[x]);
+            }
+        }
+        return sum;
+    }
+
+    static qint64 paintTime(qreal zoom, bool cacheEnabled, int repeats)
+    {
+        QImage image(IMAGE_WIDTH, IMAGE_HEIGHT, QImage::Format_ARGB32_Premultiplied);
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < repeats; ++i) {
+            paintSymbols(image, zoom, cacheEnabled);
+        }
+        return timer.nsecsElapsed() / repeats;
+    }
+};
+
+/**
+ * @brief PaintTests_symbolsCache
+ * @details Symbols blitted from the cache must look like the ones drawn as outlines.
+ *          They are placed with a quarter of a pixel precision, so only the antialiased edges may differ a bit
+ */
+TEST_F(PaintTests, symbolsCache)
+{
+    for (qreal zoom : { 0.5, 1.0, 1.37, 2.0 }) {
+        QImage outlines(IMAGE_WIDTH, IMAGE_HEIGHT, QImage::Format_ARGB32_Premultiplied);
+        paintSymbols(outlines, zoom, false);
+
+        QImage cached(IMAGE_WIDTH, IMAGE_HEIGHT, QImage::Format_ARGB32_Premultiplied);
+        paintSymbols(cached, zoom, true);
+
+        //! NOTE A second pass is served from the cache entirely
+        QImage cachedAgain(IMAGE_WIDTH, IMAGE_HEIGHT, QImage::Format_ARGB32_Premultiplied);
+        paintSymbols(cachedAgain, zoom, true);
+
+        const double expected = ink(outlines);
+        ASSERT_GT(expected, 0.0);
+        EXPECT_NEAR(ink(cached), expected, expected * 0.02) << "zoom: " << zoom;
+        EXPECT_EQ(cached, cachedAgain) << "zoom: " << zoom;
+    }
+}
+
+/**
+ * @brief PaintTests_symbolsCacheBenchmark
+ * @details Measures painting with and without the cache, at a stable zoom and while zooming in steps.
+ *          Only reports the times, the gain depends too much on the machine to be asserted.
+ *          Only runs if PAINT_SYMBOLS_TIMING is set
+ */
+TEST_F(PaintTests, symbolsCacheBenchmark)
+{
+    if (!qEnvironmentVariableIsSet("PAINT_SYMBOLS_TIMING")) {
+        GTEST_SKIP() << "set PAINT_SYMBOLS_TIMING to run";
+    }
+
+    constexpr int REPEATS = 10;
+
+    for (qreal zoom : { 0.5, 1.0, 2.0 }) {
+        const qint64 outlines = paintTime(zoom, false, REPEATS);
+        paintTime(zoom, true, 1); // warm up the cache
+        const qint64 cached = paintTime(zoom, true, REPEATS);
+
+        LOGI() << "zoom " << zoom << ": outlines " << outlines / 1000 << " us, cached " << cached / 1000
+               << " us, speedup " << double(outlines) / double(std::max<qint64>(cached, 1));
+    }
+
+    //! NOTE The worst case for the cache: every paint is at a new zoom, nothing is reused
+    qint64 outlines = 0;
+    qint64 cached = 0;
+    for (int step = 0; step < REPEATS; ++step) {
+        const qreal zoom = 0.5 + 0.1 * step;
+        outlines += paintTime(zoom, false, 1);
+        cached += paintTime(zoom, true, 1);
+    }
+
+    LOGI() << "zooming: outlines " << outlines / REPEATS / 1000 << " us, cached " << cached / REPEATS / 1000 << " us";
+}
@@ -0,0 +1,152 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/scorediff.h"
+#include "libmscore/segment.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu::engraving;
+using namespace Ms;
+
+class ScoreDiffTests : public ::testing::Test
+{
+};
+
+static std::vector<const TextDiff*> changes(const ScoreDiff& diff)
+{
+    std::vector<const TextDiff*> result;
+    for (const TextDiff& td : diff.textDiffs()) {
+        if (td.type != DiffType::EQUAL) {
+            result.push_back(&td);
+        }
+    }
+    return result;
+}
+
+//---------------------------------------------------------
+//    equal scores are matched block by block,
+//    nothing is reported
+//---------------------------------------------------------
+
+TEST_F(ScoreDiffTests, equalScores)
+{
+    MasterScore* score1 = ScoreRW::readScore("test.mscx");
+    MasterScore* score2 = ScoreRW::readScore("test.mscx");
+    ASSERT_TRUE(score1 && score2);
+
+    ScoreDiff diff(score1, score2);
+    diff.update();
+
+    EXPECT_TRUE(diff.equal());
+    EXPECT_TRUE(changes(diff).empty());
+    EXPECT_TRUE(diff.diffs().empty());
+
+    delete score1;
+    delete score2;
+}
+
+//---------------------------------------------------------
+//    a change inside one measure of one staff is found
+//    in that measure only, as a single line
+//---------------------------------------------------------
+
+TEST_F(ScoreDiffTests, changeInMeasure)
+{
+    MasterScore* score1 = ScoreRW::readScore("test.mscx");
+    MasterScore* score2 = ScoreRW::readScore("test.mscx");
+    ASSERT_TRUE(score1 && score2);
+    ASSERT_GE(score2->nstaves(), 2);
+
+    Measure* m = score2->firstMeasure()->nextMeasure();
+    ASSERT_TRUE(m);
+    Segment* s = m->first(SegmentType::ChordRest);
+    ASSERT_TRUE(s);
+    EngravingItem* cr = s->element(VOICES); // the second staff
+    ASSERT_TRUE(cr);
+
+    score2->startCmd();
+    cr->undoChangeProperty(Pid::VISIBLE, false);
+    score2->endCmd();
+
+    ScoreDiff diff(score1, score2);
+    diff.update();
+
+    EXPECT_FALSE(diff.equal());
+
+    const std::vector<const TextDiff*> textChanges = changes(diff);
+    ASSERT_EQ(textChanges.size(), 1);
+    EXPECT_EQ(textChanges.front()->type, DiffType::INSERT);
+    EXPECT_TRUE(textChanges.front()->text[1].contains("<visible>0</visible>"));
+
+    ASSERT_FALSE(diff.diffs().empty());
+    for (const BaseDiff* d : diff.diffs()) {
+        EXPECT_TRUE(d->afrac(1) >= m->tick() && d->afrac(1) < m->endTick()) << d->toString().toStdString();
+    }
+
+    //! NOTE Undoing the change makes the scores equal again
+    EditData ed;
+    score2->undoStack()->undo(&ed);
+    diff.update();
+    EXPECT_TRUE(diff.equal());
+
+    delete score1;
+    delete score2;
+}
+
+//---------------------------------------------------------
+//    an inserted measure is reported as an insertion,
+//    the measures around it are matched by their hashes
+//---------------------------------------------------------
+
+TEST_F(ScoreDiffTests, insertMeasure)
+{
+    MasterScore* score1 = ScoreRW::readScore("test.mscx");
+    MasterScore* score2 = ScoreRW::readScore("test.mscx");
+    ASSERT_TRUE(score1 && score2);
+
+    Measure* m = score2->firstMeasure()->nextMeasure();
+    ASSERT_TRUE(m);
+
+    score2->startCmd();
+    score2->insertMeasure(ElementType::MEASURE, m);
+    score2->endCmd();
+
+    ScoreDiff diff(score1, score2, true);
+    diff.update();
+
+    EXPECT_FALSE(diff.equal());
+
+    const std::vector<const TextDiff*> textChanges = changes(diff);
+    ASSERT_FALSE(textChanges.empty());
+    for (const TextDiff* td : textChanges) {
+        EXPECT_NE(td->type, DiffType::DELETE) << td->toString().toStdString();
+    }
+
+    delete score1;
+    delete score2;
+}
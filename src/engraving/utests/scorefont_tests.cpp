@@ -0,0 +1,225 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include <QCryptographicHash>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "libmscore/scorefont.h"
+#include "libmscore/symnames.h"
+
+static const QByteArray CACHE_KEY = QCryptographicHash::hash("scorefont_tests", QCryptographicHash::Sha1);
+static const QByteArray OTHER_CACHE_KEY = QCryptographicHash::hash("scorefont_tests_other", QCryptographicHash::Sha1);
+
+//! NOTE Magic (with the terminating zero), version and Sha1 key
+static constexpr int CACHE_HEADER_SIZE = 5 + 4 + 20;
+
+namespace Ms {
+class ScoreFontTests : public ::testing::Test
+{
+public:
+    static ScoreFont bravura()
+    {
+        return ScoreFont("Bravura", "Bravura", ":/fonts/bravura/", "Bravura.otf");
+    }
+
+    static ScoreFont leland()
+    {
+        return ScoreFont("Leland", "Leland", ":/fonts/leland/", "Leland.otf");
+    }
+
+    static QString cachePath(const ScoreFont& font)
+    {
+        return ScoreFont::cacheFilePath(font.m_name.toLower() + ".cache");
+    }
+
+    //! NOTE Removes whatever cache the previous runs left, so the font files are really parsed
+    static void parse(ScoreFont& font)
+    {
+        QFile::remove(cachePath(font));
+        font.load();
+    }
+
+    static void load(ScoreFont& font)
+    {
+        font.load();
+    }
+
+    static bool isLoaded(const ScoreFont& font)
+    {
+        return font.m_loaded;
+    }
+
+    static bool readCache(ScoreFont& font, const QString& path, const QByteArray& key)
+    {
+        return font.readCache(path, key);
+    }
+
+    static void writeCache(const ScoreFont& font, const QString& path, const QByteArray& key)
+    {
+        font.writeCache(path, key);
+    }
+
+    static size_t validSymbolsCount(const ScoreFont& font)
+    {
+        return std::count_if(font.m_symbols.cbegin(), font.m_symbols.cend(), [](const ScoreFont::Sym& sym) {
+            return sym.isValid();
+        });
+    }
+
+    static void expectSameMetrics(const ScoreFont& expected, const ScoreFont& actual)
+    {
+        ASSERT_EQ(expected.m_symbols.size(), actual.m_symbols.size());
+
+        for (size_t id = 0; id < expected.m_symbols.size(); ++id) {
+            const ScoreFont::Sym& e = expected.m_symbols[id];
+            const ScoreFont::Sym& a = actual.m_symbols[id];
+            const char* name = SymNames::nameForSymId(static_cast<SymId>(id));
+
+            EXPECT_EQ(e.code, a.code) << name;
+            EXPECT_TRUE(e.bbox == a.bbox) << name;
+            EXPECT_EQ(e.advance, a.advance) << name;
+            EXPECT_TRUE(e.smuflAnchors == a.smuflAnchors) << name;
+            EXPECT_TRUE(e.subSymbolIds == a.subSymbolIds) << name;
+        }
+
+        EXPECT_TRUE(expected.m_engravingDefaults == actual.m_engravingDefaults);
+        EXPECT_EQ(expected.m_textEnclosureThickness, actual.m_textEnclosureThickness);
+    }
+
+    static QByteArray readFile(const QString& path)
+    {
+        QFile file(path);
+        return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+    }
+
+    static void writeFile(const QString& path, const QByteArray& data)
+    {
+        QFile file(path);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(data);
+    }
+};
+
+/**
+ * @brief ScoreFontTests_cacheRoundTrip
+ * @details A font read back from its cache has exactly the glyph metrics and metadata of a freshly parsed one
+ */
+TEST_F(ScoreFontTests, cacheRoundTrip)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.filePath("bravura.cache");
+
+    ScoreFont parsed = bravura();
+    parse(parsed);
+    ASSERT_TRUE(isLoaded(parsed));
+    ASSERT_GT(validSymbolsCount(parsed), 0u);
+
+    writeCache(parsed, path, CACHE_KEY);
+
+    ScoreFont cached = bravura();
+    ASSERT_TRUE(readCache(cached, path, CACHE_KEY));
+    expectSameMetrics(parsed, cached);
+
+    //! NOTE The same through load(), which finds the cache parse() has just written
+    ScoreFont reloaded = bravura();
+    ASSERT_FALSE(readFile(cachePath(reloaded)).isEmpty());
+    load(reloaded);
+    ASSERT_TRUE(isLoaded(reloaded));
+    expectSameMetrics(parsed, reloaded);
+}
+
+/**
+ * @brief ScoreFontTests_staleCacheIsRejected
+ * @details A cache written for other source files is ignored, and load() parses the font instead
+ */
+TEST_F(ScoreFontTests, staleCacheIsRejected)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.filePath("bravura.cache");
+
+    ScoreFont parsed = bravura();
+    parse(parsed);
+    writeCache(parsed, path, CACHE_KEY);
+
+    ScoreFont cached = bravura();
+    EXPECT_FALSE(readCache(cached, path, OTHER_CACHE_KEY));
+    EXPECT_EQ(validSymbolsCount(cached), 0u);
+
+    //! NOTE Leave another font's metrics where load() looks for the Bravura cache
+    ScoreFont other = leland();
+    parse(other);
+    writeCache(other, cachePath(parsed), CACHE_KEY);
+
+    ScoreFont reloaded = bravura();
+    load(reloaded);
+    ASSERT_TRUE(isLoaded(reloaded));
+    expectSameMetrics(parsed, reloaded);
+}
+
+/**
+ * @brief ScoreFontTests_corruptCacheIsRejected
+ * @details A truncated or damaged cache is rejected and leaves the font untouched
+ */
+TEST_F(ScoreFontTests, corruptCacheIsRejected)
+{
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const QString path = dir.filePath("bravura.cache");
+
+    ScoreFont parsed = bravura();
+    parse(parsed);
+    writeCache(parsed, path, CACHE_KEY);
+
+    const QByteArray data = readFile(path);
+    ASSERT_GT(data.size(), CACHE_HEADER_SIZE);
+
+    QByteArray badMagic = data;
+    badMagic[0] = 'X';
+
+    QByteArray garbagePayload = data.left(CACHE_HEADER_SIZE);
+    garbagePayload.append(data.size() - CACHE_HEADER_SIZE, char(0xFF));
+
+    const std::vector<QByteArray> corruptions = {
+        QByteArray(),
+        data.left(CACHE_HEADER_SIZE - 1),
+        data.left(data.size() / 2),
+        data.left(data.size() - 1),
+        badMagic,
+        garbagePayload
+    };
+
+    for (size_t i = 0; i < corruptions.size(); ++i) {
+        writeFile(path, corruptions[i]);
+
+        ScoreFont cached = bravura();
+        EXPECT_FALSE(readCache(cached, path, CACHE_KEY)) << "corruption " << i;
+        EXPECT_EQ(validSymbolsCount(cached), 0u) << "corruption " << i;
+    }
+}
+}
@@ -0,0 +1,291 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "libmscore/chordrest.h"
+#include "libmscore/masterscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/mscore.h"
+#include "libmscore/segment.h"
+#include "libmscore/stafftext.h"
+#include "libmscore/textedit.h"
+#include "libmscore/undo.h"
+
+#include "utils/scorerw.h"
+
+using namespace mu::engraving;
+using namespace Ms;
+
+class UndoTests : public ::testing::Test
+{
+public:
+    void TearDown() override
+    {
+        MScore::undoMemoryBudget = 0;
+    }
+};
+
+static EngravingItem* firstChordRest(Score* score)
+{
+    Segment* s = score->firstMeasure()->first(SegmentType::ChordRest);
+    return s ? s->element(0) : nullptr;
+}
+
+static int visibilityChanges(const UndoMacro* macro, const EngravingItem* e)
+{
+    int count = 0;
+    for (const UndoCommand* cmd : macro->commands()) {
+        if (strcmp(cmd->name(), "ChangeProperty") != 0) {
+            continue;
+        }
+        const ChangeProperty* cp = static_cast<const ChangeProperty*>(cmd);
+        if (cp->getElement() == e && cp->getId() == Pid::VISIBLE) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+//---------------------------------------------------------
+//    repeated changes of one property within a command
+//    are stored once and still undo/redo correctly
+//---------------------------------------------------------
+
+TEST_F(UndoTests, mergePropertyChanges)
+{
+    MasterScore* score = ScoreRW::readScore("test.mscx");
+    ASSERT_TRUE(score);
+
+    EngravingItem* cr = firstChordRest(score);
+    ASSERT_TRUE(cr);
+    ASSERT_TRUE(cr->visible());
+
+    score->startCmd();
+    cr->undoChangeProperty(Pid::VISIBLE, false);
+    cr->undoChangeProperty(Pid::VISIBLE, true);
+    cr->undoChangeProperty(Pid::VISIBLE, false);
+    score->endCmd();
+
+    EXPECT_EQ(visibilityChanges(score->undoStack()->last(), cr), 1);
+    EXPECT_FALSE(cr->visible());
+
+    EditData ed;
+    score->undoStack()->undo(&ed);
+    EXPECT_TRUE(cr->visible());
+
+    score->undoStack()->redo(&ed);
+    EXPECT_FALSE(cr->visible());
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//    the oldest undo steps are dropped once the history
+//    exceeds MScore::undoMemoryBudget
+//---------------------------------------------------------
+
+TEST_F(UndoTests, memoryBudget)
+{
+    MasterScore* score = ScoreRW::readScore("test.mscx");
+    ASSERT_TRUE(score);
+
+    EngravingItem* cr = firstChordRest(score);
+    ASSERT_TRUE(cr);
+
+    UndoStack* undoStack = score->undoStack();
+
+    score->startCmd();
+    cr->undoChangeProperty(Pid::VISIBLE, false);
+    score->endCmd();
+
+    const size_t stepCost = undoStack->last()->memoryCost();
+    EXPECT_GT(stepCost, 0);
+
+    MScore::undoMemoryBudget = stepCost * 3;
+
+    for (int i = 0; i < 10; ++i) {
+        score->startCmd();
+        cr->undoChangeProperty(Pid::VISIBLE, !cr->visible());
+        score->endCmd();
+
+        EXPECT_LE(undoStack->memoryCost(), MScore::undoMemoryBudget + stepCost);
+    }
+
+    EXPECT_LT(undoStack->size(), 11);
+    EXPECT_TRUE(undoStack->canUndo());
+
+    //! NOTE The remaining steps must still be undoable
+    EditData ed;
+    while (undoStack->canUndo()) {
+        undoStack->undo(&ed);
+    }
+    EXPECT_FALSE(undoStack->canUndo());
+
+    //! NOTE A single step is kept even if it alone exceeds the budget
+    MScore::undoMemoryBudget = 1;
+
+    score->startCmd();
+    cr->undoChangeProperty(Pid::VISIBLE, !cr->visible());
+    score->endCmd();
+
+    EXPECT_EQ(undoStack->size(), 1);
+    EXPECT_TRUE(undoStack->canUndo());
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//    a text edit at the memory budget: every keystroke
+//    drops the oldest step, the undo indices saved by the
+//    edit must still find its steps
+//---------------------------------------------------------
+
+TEST_F(UndoTests, memoryBudgetTextEdit)
+{
+    MasterScore* score = ScoreRW::readScore("test.mscx");
+    ASSERT_TRUE(score);
+
+    EngravingItem* cr = firstChordRest(score);
+    ASSERT_TRUE(cr && cr->isChordRest());
+
+    UndoStack* undoStack = score->undoStack();
+
+    StaffText* staffText = new StaffText(score->dummy()->segment());
+    staffText->setPlainText("old");
+    EditData dropData;
+    dropData.dropElement = staffText;
+    score->startCmd();
+    toChordRest(cr)->drop(dropData);
+    score->endCmd();
+
+    //! NOTE Only the most recent step fits into the budget
+    MScore::undoMemoryBudget = 1;
+
+    score->startCmd();
+    cr->undoChangeProperty(Pid::VISIBLE, false);
+    score->endCmd();
+    ASSERT_EQ(undoStack->size(), 1);
+
+    EditData ed;
+    ed.element = staffText;
+    staffText->startEdit(ed);
+    staffText->cursor()->moveCursorToEnd();
+
+    for (const char* s : { "a", "b", "c" }) {
+        const int idx = undoStack->getCurIdx();
+        score->startCmd();
+        score->undo(new InsertText(staffText->cursor(), QString(s)), &ed);
+        score->endCmd();
+
+        EXPECT_EQ(undoStack->size(), 1);
+        EXPECT_EQ(undoStack->getCurIdx(), idx + 1);
+    }
+
+    staffText->endEdit(ed);
+
+    EXPECT_EQ(staffText->plainText(), "oldabc");
+    ASSERT_TRUE(undoStack->canUndo());
+
+    //! NOTE The whole edit is undone at once, the earlier steps are gone
+    EditData undoData;
+    undoStack->undo(&undoData);
+    EXPECT_EQ(staffText->plainText(), "old");
+    EXPECT_FALSE(cr->visible());
+    EXPECT_FALSE(undoStack->canUndo());
+
+    undoStack->redo(&undoData);
+    EXPECT_EQ(staffText->plainText(), "oldabc");
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//    measure content hashes follow undoable edits:
+//    only the edited staff changes, and redoing a step
+//    gives the hash it had after the edit
+//---------------------------------------------------------
+
+TEST_F(UndoTests, contentHash)
+{
+    MasterScore* score = ScoreRW::readScore("test.mscx");
+    ASSERT_TRUE(score);
+    ASSERT_GE(score->nstaves(), 2);
+
+    EngravingItem* cr = firstChordRest(score);
+    ASSERT_TRUE(cr);
+    ASSERT_EQ(cr->staffIdx(), 0);
+
+    Measure* m = score->firstMeasure();
+    const uint64_t staff0Before = m->contentHash(0);
+    const uint64_t staff1Before = m->contentHash(1);
+    const uint64_t measureBefore = m->contentHash();
+
+    score->startCmd();
+    cr->undoChangeProperty(Pid::VISIBLE, false);
+    score->endCmd();
+
+    const uint64_t staff0Edited = m->contentHash(0);
+    EXPECT_NE(staff0Edited, staff0Before);
+    EXPECT_EQ(m->contentHash(1), staff1Before);
+    EXPECT_NE(m->contentHash(), measureBefore);
+
+    const uint64_t measureEdited = m->contentHash();
+
+    //! NOTE Undo gives back exactly the hashes from before the edit, redo the ones after it
+    EditData ed;
+    score->undoStack()->undo(&ed);
+    EXPECT_EQ(m->contentHash(0), staff0Before);
+    EXPECT_EQ(m->contentHash(1), staff1Before);
+    EXPECT_EQ(m->contentHash(), measureBefore);
+
+    score->undoStack()->redo(&ed);
+    EXPECT_EQ(m->contentHash(0), staff0Edited);
+    EXPECT_EQ(m->contentHash(1), staff1Before);
+    EXPECT_EQ(m->contentHash(), measureEdited);
+
+    score->undoStack()->undo(&ed);
+    EXPECT_EQ(m->contentHash(0), staff0Before);
+    EXPECT_EQ(m->contentHash(), measureBefore);
+
+    //! NOTE A rolled back command leaves no trace either
+    score->startCmd();
+    cr->undoChangeProperty(Pid::VISIBLE, false);
+    score->endCmd(true);
+    EXPECT_EQ(m->contentHash(0), staff0Before);
+    EXPECT_EQ(m->contentHash(), measureBefore);
+
+    score->undoStack()->redo(&ed);
+    EXPECT_EQ(m->contentHash(0), staff0Edited);
+    EXPECT_EQ(m->contentHash(), measureEdited);
+
+    //! NOTE Changes that can't be attributed to measures change every hash
+    score->startCmd();
+    score->undo(new ChangeStyleVal(score, Sid::spatium, score->styleV(Sid::spatium)));
+    score->endCmd();
+    EXPECT_NE(m->contentHash(0), staff0Edited);
+    EXPECT_NE(m->contentHash(1), staff1Before);
+
+    delete score;
+}
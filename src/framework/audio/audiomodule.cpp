@@ -32,6 +32,7 @@
 #include "internal/audiothread.h"
 #include "internal/audiobuffer.h"
 #include "internal/audiothreadsecurer.h"
+#include "internal/audioprofiler.h"
 
 #include "internal/worker/audioengine.h"
 #include "internal/worker/playback.h"
@@ -44,6 +45,7 @@
 
 #include "view/synthssettingsmodel.h"
 #include "devtools/waveformmodel.h"
+#include "devtools/audioprofilermodel.h"
 
 #include "diagnostics/idiagnosticspathsregister.h"
 
@@ -83,6 +85,8 @@ static std::shared_ptr<IAudioDriver> s_audioDriver = std::shared_ptr<IAudioDrive
 #ifdef Q_OS_WASM
 #include "internal/platform/web/webaudiodriver.h"
 static std::shared_ptr<IAudioDriver> s_audioDriver = std::shared_ptr<IAudioDriver>(new WebAudioDriver());
+#else
+#include "internal/platform/file/fileaudiodriver.h"
 #endif
 
 static void audio_init_qrc()
@@ -102,6 +106,13 @@ std::string AudioModule::moduleName() const
 
 void AudioModule::registerExports()
 {
+#ifndef Q_OS_WASM
+    io::path renderFilePath = s_audioConfiguration->renderFilePath();
+    if (!renderFilePath.empty()) {
+        s_audioDriver = std::make_shared<FileAudioDriver>(renderFilePath);
+    }
+#endif
+
     ioc()->registerExport<IAudioConfiguration>(moduleName(), s_audioConfiguration);
     ioc()->registerExport<IAudioThreadSecurer>(moduleName(), std::make_shared<AudioThreadSecurer>());
     ioc()->registerExport<IAudioDriver>(moduleName(), s_audioDriver);
@@ -119,6 +130,7 @@ void AudioModule::registerResources()
 void AudioModule::registerUiTypes()
 {
     qmlRegisterType<WaveFormModel>("MuseScore.Audio", 1, 0, "WaveFormModel");
+    qmlRegisterType<AudioProfilerModel>("MuseScore.Audio", 1, 0, "AudioProfilerModel");
     qmlRegisterType<synth::SynthsSettingsModel>("MuseScore.Audio", 1, 0, "SynthsSettingsModel");
 
     ioc()->resolve<ui::IUiEngine>(moduleName())->addSourceImportPath(audio_QML_IMPORT);
@@ -231,5 +243,10 @@ void AudioModule::onDeinit()
             ONLY_AUDIO_WORKER_THREAD;
             AudioEngine::instance()->deinit();
         });
+
+        AudioProfiler::Summary profile = AudioProfiler::instance()->summary();
+        if (profile.blockMsecs.count > 0) {
+            LOGI() << "audio profile:\n" << profile.toString();
+        }
     }
 }
@@ -255,6 +255,27 @@ private:
     std::map<audioch_t, AudioSignalVal> m_signalValuesMap;
 };
 
+struct SynthesizerLoad {
+    unsigned int activeVoices = 0;
+    unsigned int polyphony = 0;
+    unsigned int stolenVoices = 0;
+    unsigned int overruns = 0;
+    float renderLoad = 0.f; // share of the real time spent on rendering
+
+    bool operator ==(const SynthesizerLoad& other) const
+    {
+        return activeVoices == other.activeVoices
+               && polyphony == other.polyphony
+               && stolenVoices == other.stolenVoices
+               && overruns == other.overruns
+               && RealIsEqual(renderLoad, other.renderLoad);
+    }
+
+    bool operator !=(const SynthesizerLoad& other) const { return !operator ==(other); }
+};
+
+using SynthesizerLoadChanges = async::Channel<TrackId, SynthesizerLoad>;
+
 using PlaybackData = std::variant<midi::MidiData, io::Device*>;
 
 enum class PlaybackStatus {
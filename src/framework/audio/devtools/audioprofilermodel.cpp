@@ -0,0 +1,49 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "audioprofilermodel.h"
+
+#include "internal/audioprofiler.h"
+
+using namespace mu::audio;
+
+AudioProfilerModel::AudioProfilerModel(QObject* parent)
+    : QObject(parent)
+{
+}
+
+QString AudioProfilerModel::summary() const
+{
+    return m_summary;
+}
+
+void AudioProfilerModel::refresh()
+{
+    //! NOTE The profiler is lock-free, reading it from the main thread doesn't block the audio
+    m_summary = QString::fromStdString(AudioProfiler::instance()->summary().toString());
+    emit summaryChanged();
+}
+
+void AudioProfilerModel::reset()
+{
+    AudioProfiler::instance()->reset();
+    refresh();
+}
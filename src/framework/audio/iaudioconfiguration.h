@@ -46,6 +46,9 @@ public:
     virtual audioch_t audioChannelsCount() const = 0;
     virtual unsigned int driverBufferSize() const = 0; // samples
 
+    //! NOTE If set, the audio is rendered to the file instead of the audio device
+    virtual io::path renderFilePath() const = 0;
+
     virtual bool isShowControlsInMixer() const = 0;
     virtual void setIsShowControlsInMixer(bool show) = 0;
 
@@ -25,6 +25,8 @@
 
 #include "log.h"
 
+#include "audioprofiler.h"
+
 using namespace mu::audio;
 
 void AudioBuffer::init(const audioch_t audioChannelsCount, const samples_t samplesPerChannel)
@@ -53,6 +55,11 @@ void AudioBuffer::pop(float* dest, size_t sampleCount)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
 
+    //! NOTE The worker didn't manage to fill the buffer in time, the driver plays the stale data
+    if (sampleLag() < sampleCount) {
+        AudioProfiler::instance()->recordXrun();
+    }
+
     size_t from = m_readIndex;
     auto memStep = sizeof(float);
     size_t to = m_readIndex + sampleCount * m_audioChannelsCount;
@@ -90,6 +97,8 @@ void AudioBuffer::fillup()
         return;
     }
 
+    AudioProfiler::instance()->recordBufferFill(sampleLag());
+
     while (sampleLag() < m_minSampleLag + FILL_OVER) {
         m_source->process(m_data.data() + m_writeIndex, FILL_SAMPLES);
         updateWriteIndex(FILL_SAMPLES);
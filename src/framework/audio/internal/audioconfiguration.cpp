@@ -20,6 +20,9 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include "audioconfiguration.h"
+
+#include <cstdlib>
+
 #include "settings.h"
 #include "stringutils.h"
 
@@ -96,6 +99,12 @@ unsigned int AudioConfiguration::driverBufferSize() const
     return settings()->value(AUDIO_BUFFER_SIZE).toInt();
 }
 
+io::path AudioConfiguration::renderFilePath() const
+{
+    const char* path = std::getenv("MU_AUDIO_RENDER_FILE");
+    return path ? io::path(path) : io::path();
+}
+
 SoundFontPaths AudioConfiguration::soundFontDirectories() const
 {
     std::string pathsStr = settings()->value(USER_SOUNDFONTS_PATH).toString();
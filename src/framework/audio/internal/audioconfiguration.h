@@ -43,6 +43,8 @@ public:
     audioch_t audioChannelsCount() const override;
     unsigned int driverBufferSize() const override;
 
+    io::path renderFilePath() const override;
+
     io::paths soundFontDirectories() const override;
     async::Channel<io::paths> soundFontDirectoriesChanged() const override;
 
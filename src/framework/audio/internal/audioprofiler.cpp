@@ -0,0 +1,250 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "audioprofiler.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+using namespace mu::audio;
+
+static uint64_t toNanosecs(AudioProfiler::Duration duration)
+{
+    return static_cast<uint64_t>(std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+}
+
+static uint64_t packKey(uint8_t stage, TrackId trackId, size_t index)
+{
+    return (static_cast<uint64_t>(stage) << 56)
+           | (static_cast<uint64_t>(index & 0xFFFFFF) << 32)
+           | static_cast<uint32_t>(trackId);
+}
+
+static AudioProfiler::Stats makeStats(std::vector<double>& values)
+{
+    AudioProfiler::Stats stats;
+    if (values.empty()) {
+        return stats;
+    }
+
+    std::sort(values.begin(), values.end());
+
+    auto percentile = [&values](double p) {
+        size_t idx = static_cast<size_t>(p * (values.size() - 1) + 0.5);
+        return values[idx];
+    };
+
+    stats.count = values.size();
+    stats.p50 = percentile(0.50);
+    stats.p95 = percentile(0.95);
+    stats.p99 = percentile(0.99);
+    stats.max = values.back();
+
+    return stats;
+}
+
+AudioProfiler* AudioProfiler::instance()
+{
+    static AudioProfiler p;
+    return &p;
+}
+
+void AudioProfiler::recordBlock(Duration renderTime, samples_t samplesPerChannel, unsigned int sampleRate)
+{
+    if (sampleRate == 0) {
+        return;
+    }
+
+    uint64_t blockNanosecs = samplesPerChannel * 1000000000 / sampleRate;
+    record(Stage::Block, 0, 0, toNanosecs(renderTime), blockNanosecs);
+}
+
+void AudioProfiler::recordChannel(TrackId trackId, Duration renderTime)
+{
+    record(Stage::Channel, trackId, 0, toNanosecs(renderTime));
+}
+
+void AudioProfiler::recordChannelFx(TrackId trackId, size_t fxIndex, Duration renderTime)
+{
+    record(Stage::ChannelFx, trackId, fxIndex, toNanosecs(renderTime));
+}
+
+void AudioProfiler::recordMasterFx(size_t fxIndex, Duration renderTime)
+{
+    record(Stage::MasterFx, 0, fxIndex, toNanosecs(renderTime));
+}
+
+void AudioProfiler::recordBufferFill(samples_t samplesPerChannel)
+{
+    record(Stage::BufferFill, 0, 0, samplesPerChannel);
+}
+
+void AudioProfiler::recordXrun()
+{
+    m_xruns.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AudioProfiler::recordSeek(TrackId trackId, Duration latency, bool isPrefetched)
+{
+    record(Stage::Seek, trackId, isPrefetched ? 1 : 0, toNanosecs(latency));
+}
+
+void AudioProfiler::record(Stage stage, TrackId trackId, size_t index, uint64_t value, uint64_t duration)
+{
+    uint64_t writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+    Record& r = m_records[writeIndex % CAPACITY];
+
+    // odd while writing, even when written
+    r.sequence.store(writeIndex * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    r.key.store(packKey(static_cast<uint8_t>(stage), trackId, index), std::memory_order_relaxed);
+    r.value.store(value, std::memory_order_relaxed);
+    r.duration.store(duration, std::memory_order_relaxed);
+
+    r.sequence.store(writeIndex * 2 + 2, std::memory_order_release);
+    m_writeIndex.store(writeIndex + 1, std::memory_order_release);
+}
+
+AudioProfiler::Summary AudioProfiler::summary() const
+{
+    uint64_t writeIndex = m_writeIndex.load(std::memory_order_acquire);
+    uint64_t firstIndex = std::max(m_resetIndex.load(std::memory_order_relaxed),
+                                   writeIndex > CAPACITY ? writeIndex - CAPACITY : 0);
+
+    std::vector<double> blockMsecs;
+    std::vector<double> blockLoad;
+    std::vector<double> bufferFill;
+    std::vector<double> seekMsecs;
+    size_t prefetchedSeeks = 0;
+    std::map<uint64_t, std::vector<double>> stageMsecs;
+
+    for (uint64_t i = firstIndex; i < writeIndex; ++i) {
+        const Record& r = m_records[i % CAPACITY];
+
+        uint64_t sequence = r.sequence.load(std::memory_order_acquire);
+        uint64_t key = r.key.load(std::memory_order_relaxed);
+        uint64_t value = r.value.load(std::memory_order_relaxed);
+        uint64_t duration = r.duration.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (sequence != i * 2 + 2 || r.sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+
+        Stage stage = static_cast<Stage>(key >> 56);
+        switch (stage) {
+        case Stage::Block:
+            blockMsecs.push_back(value / 1e6);
+            if (duration > 0) {
+                blockLoad.push_back(static_cast<double>(value) / duration);
+            }
+            break;
+        case Stage::BufferFill:
+            bufferFill.push_back(static_cast<double>(value));
+            break;
+        case Stage::Seek:
+            seekMsecs.push_back(value / 1e6);
+            if ((key >> 32) & 0xFFFFFF) {
+                prefetchedSeeks++;
+            }
+            break;
+        case Stage::Channel:
+        case Stage::ChannelFx:
+        case Stage::MasterFx:
+            stageMsecs[key].push_back(value / 1e6);
+            break;
+        }
+    }
+
+    Summary s;
+    s.blockMsecs = makeStats(blockMsecs);
+    s.blockLoad = makeStats(blockLoad);
+    s.bufferFillSamples = makeStats(bufferFill);
+    s.xruns = m_xruns.load(std::memory_order_relaxed) - m_resetXruns.load(std::memory_order_relaxed);
+    s.seekMsecs = makeStats(seekMsecs);
+    s.prefetchedSeeks = prefetchedSeeks;
+
+    for (auto& pair : stageMsecs) {
+        Stage stage = static_cast<Stage>(pair.first >> 56);
+        size_t index = static_cast<size_t>((pair.first >> 32) & 0xFFFFFF);
+        TrackId trackId = static_cast<TrackId>(static_cast<uint32_t>(pair.first));
+
+        switch (stage) {
+        case Stage::Channel:
+            s.channelMsecs[trackId] = makeStats(pair.second);
+            break;
+        case Stage::ChannelFx:
+            s.channelFxMsecs[{ trackId, index }] = makeStats(pair.second);
+            break;
+        case Stage::MasterFx:
+            s.masterFxMsecs[index] = makeStats(pair.second);
+            break;
+        default:
+            break;
+        }
+    }
+
+    return s;
+}
+
+void AudioProfiler::reset()
+{
+    m_resetIndex.store(m_writeIndex.load(std::memory_order_acquire), std::memory_order_relaxed);
+    m_resetXruns.store(m_xruns.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+std::string AudioProfiler::Summary::toString() const
+{
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+
+    auto writeStats = [&ss](const std::string& name, const Stats& stats, const std::string& unit) {
+        ss << name << ": p50 " << stats.p50 << unit
+           << ", p95 " << stats.p95 << unit
+           << ", p99 " << stats.p99 << unit
+           << ", max " << stats.max << unit
+           << " (" << stats.count << ")\n";
+    };
+
+    writeStats("block", blockMsecs, " ms");
+    writeStats("block load", blockLoad, "");
+    writeStats("buffer fill", bufferFillSamples, " samples");
+    ss << "xruns: " << xruns << "\n";
+    writeStats("seek", seekMsecs, " ms");
+    ss << "prefetched seeks: " << prefetchedSeeks << "/" << seekMsecs.count << "\n";
+
+    for (const auto& pair : channelMsecs) {
+        writeStats("track " + std::to_string(pair.first), pair.second, " ms");
+    }
+
+    for (const auto& pair : channelFxMsecs) {
+        writeStats("track " + std::to_string(pair.first.first) + " fx " + std::to_string(pair.first.second), pair.second, " ms");
+    }
+
+    for (const auto& pair : masterFxMsecs) {
+        writeStats("master fx " + std::to_string(pair.first), pair.second, " ms");
+    }
+
+    return ss.str();
+}
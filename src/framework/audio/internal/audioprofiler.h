@@ -0,0 +1,113 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_AUDIOPROFILER_H
+#define MU_AUDIO_AUDIOPROFILER_H
+
+#include <atomic>
+#include <array>
+#include <chrono>
+#include <map>
+#include <string>
+
+#include "audiotypes.h"
+
+namespace mu::audio {
+//! NOTE Collects the timings of the audio blocks without locks, so that measuring doesn't disturb the audio.
+//! The worker thread is the only writer of the timings and the driver thread is the only writer of the xruns,
+//! the summary can be read from any thread
+class AudioProfiler
+{
+public:
+    using Duration = std::chrono::steady_clock::duration;
+
+    static AudioProfiler* instance();
+
+    //! NOTE The number of the latest records the summary is made of
+    static constexpr size_t CAPACITY = 16384;
+
+    struct Stats {
+        size_t count = 0;
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+    };
+
+    struct Summary {
+        Stats blockMsecs;
+        Stats blockLoad; // render time / duration of the block
+        Stats bufferFillSamples;
+        uint64_t xruns = 0;
+
+        Stats seekMsecs; // from a seek until the events of the new position are there to be rendered
+        size_t prefetchedSeeks = 0;
+
+        std::map<TrackId, Stats> channelMsecs;
+        std::map<std::pair<TrackId, size_t>, Stats> channelFxMsecs;
+        std::map<size_t, Stats> masterFxMsecs;
+
+        std::string toString() const;
+    };
+
+    void recordBlock(Duration renderTime, samples_t samplesPerChannel, unsigned int sampleRate);
+    void recordChannel(TrackId trackId, Duration renderTime);
+    void recordChannelFx(TrackId trackId, size_t fxIndex, Duration renderTime);
+    void recordMasterFx(size_t fxIndex, Duration renderTime);
+    void recordBufferFill(samples_t samplesPerChannel);
+    void recordXrun();
+    void recordSeek(TrackId trackId, Duration latency, bool isPrefetched);
+
+    Summary summary() const;
+    void reset();
+
+private:
+    AudioProfiler() = default;
+
+    enum class Stage : uint8_t {
+        Block = 0,
+        Channel,
+        ChannelFx,
+        MasterFx,
+        BufferFill,
+        Seek
+    };
+
+    //! NOTE Every record is guarded by its sequence number like a seqlock:
+    //! the reader drops the records that the writer has overwritten while they were being read
+    struct Record {
+        std::atomic<uint64_t> sequence { 0 };
+        std::atomic<uint64_t> key { 0 };
+        std::atomic<uint64_t> value { 0 };
+        std::atomic<uint64_t> duration { 0 };
+    };
+
+    void record(Stage stage, TrackId trackId, size_t index, uint64_t value, uint64_t duration = 0);
+
+    std::array<Record, CAPACITY> m_records;
+    std::atomic<uint64_t> m_writeIndex { 0 };
+    std::atomic<uint64_t> m_resetIndex { 0 };
+    std::atomic<uint64_t> m_xruns { 0 };
+    std::atomic<uint64_t> m_resetXruns { 0 };
+};
+}
+
+#endif // MU_AUDIO_AUDIOPROFILER_H
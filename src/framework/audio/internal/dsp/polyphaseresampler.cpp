@@ -0,0 +1,235 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "polyphaseresampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "log.h"
+
+using namespace mu::audio::dsp;
+
+static constexpr unsigned int MIN_TAPS_COUNT = 64;
+static constexpr unsigned int MAX_TAPS_COUNT = 512;
+static constexpr unsigned int MAX_PHASES_COUNT = 512;
+static constexpr double KAISER_BETA = 8.96; // about 90 dB of stopband attenuation
+
+static double zeroBessel(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    double halfX = x / 2.0;
+
+    for (int k = 1; term > sum * 1e-12; ++k) {
+        double factor = halfX / k;
+        term *= factor * factor;
+        sum += term;
+    }
+
+    return sum;
+}
+
+static double sinc(double x)
+{
+    if (x == 0.0) {
+        return 1.0;
+    }
+
+    return std::sin(M_PI * x) / (M_PI * x);
+}
+
+//! NOTE Four independent sums let the compiler turn this into SIMD multiply-adds
+static inline float dotProduct(const float* a, const float* b, unsigned int size)
+{
+    float sum0 = 0.f;
+    float sum1 = 0.f;
+    float sum2 = 0.f;
+    float sum3 = 0.f;
+
+    for (unsigned int i = 0; i < size; i += 4) {
+        sum0 += a[i] * b[i];
+        sum1 += a[i + 1] * b[i + 1];
+        sum2 += a[i + 2] * b[i + 2];
+        sum3 += a[i + 3] * b[i + 3];
+    }
+
+    return (sum0 + sum1) + (sum2 + sum3);
+}
+
+PolyphaseResampler::PolyphaseResampler(unsigned int channelsCount, unsigned int sampleRateIn, unsigned int sampleRateOut)
+    : m_channelsCount(channelsCount)
+{
+    IF_ASSERT_FAILED(channelsCount > 0 && sampleRateIn > 0 && sampleRateOut > 0) {
+        m_channelsCount = std::max(channelsCount, 1u);
+        sampleRateIn = sampleRateOut = 1;
+    }
+
+    initFilterBank(sampleRateIn, sampleRateOut);
+    reset();
+}
+
+unsigned int PolyphaseResampler::channelsCount() const
+{
+    return m_channelsCount;
+}
+
+unsigned int PolyphaseResampler::tapsCount() const
+{
+    return m_tapsCount;
+}
+
+void PolyphaseResampler::initFilterBank(unsigned int sampleRateIn, unsigned int sampleRateOut)
+{
+    unsigned int gcd = std::gcd(sampleRateIn, sampleRateOut);
+    m_L = sampleRateOut / gcd;
+    m_M = sampleRateIn / gcd;
+
+    //! NOTE For the uncommon rate pairs with a huge interpolation factor the bank is interpolated
+    m_phasesCount = static_cast<unsigned int>(std::min<uint64_t>(m_L, MAX_PHASES_COUNT));
+
+    //! NOTE When downsampling, the cutoff moves down to the output Nyquist frequency,
+    //! the filter gets proportionally longer to keep the same transition band
+    double cutoff = std::min(1.0, static_cast<double>(sampleRateOut) / static_cast<double>(sampleRateIn));
+    unsigned int tapsCount = static_cast<unsigned int>(std::ceil(MIN_TAPS_COUNT / cutoff));
+    m_tapsCount = std::min((tapsCount + 7) / 8 * 8, MAX_TAPS_COUNT);
+
+    double halfLength = m_tapsCount / 2.0;
+    double windowNorm = zeroBessel(KAISER_BETA);
+
+    //! NOTE One extra phase, so that the interpolation always has a next phase
+    m_filterBank.assign(static_cast<size_t>(m_phasesCount + 1) * m_tapsCount, 0.f);
+
+    for (unsigned int phase = 0; phase <= m_phasesCount; ++phase) {
+        float* coefficients = &m_filterBank[static_cast<size_t>(phase) * m_tapsCount];
+        double fraction = static_cast<double>(phase) / m_phasesCount;
+        double sum = 0.0;
+
+        std::vector<double> values(m_tapsCount);
+        for (unsigned int tap = 0; tap < m_tapsCount; ++tap) {
+            double distance = tap - (halfLength - 1.0) - fraction;
+            double x = distance / halfLength;
+            double window = zeroBessel(KAISER_BETA * std::sqrt(std::max(0.0, 1.0 - x * x))) / windowNorm;
+
+            values[tap] = cutoff * sinc(cutoff * distance) * window;
+            sum += values[tap];
+        }
+
+        //! NOTE Normalize every sub-filter to the unity DC gain, so that the phases don't modulate the level
+        for (unsigned int tap = 0; tap < m_tapsCount; ++tap) {
+            coefficients[tap] = static_cast<float>(values[tap] / sum);
+        }
+    }
+}
+
+uint64_t PolyphaseResampler::reset(uint64_t outputFrame)
+{
+    m_history.assign(static_cast<size_t>(m_channelsCount) * m_tapsCount * 2, 0.f);
+    m_historyPos = 0;
+    m_outputFrame = outputFrame;
+
+    //! NOTE Input frames are counted from m_tapsCount frames before the signal start,
+    //! the history initially holds the zero padding before the signal
+    uint64_t firstInputFrame = requiredInputFrames(outputFrame) - m_tapsCount;
+    m_inputFrame = std::max<uint64_t>(firstInputFrame, m_tapsCount);
+
+    return m_inputFrame - m_tapsCount;
+}
+
+size_t PolyphaseResampler::process(const float* input, size_t inputFrames, size_t& inputFramesUsed, float* output, size_t outputFrames)
+{
+    size_t writtenFrames = 0;
+    inputFramesUsed = 0;
+
+    while (writtenFrames < outputFrames) {
+        if (m_inputFrame == requiredInputFrames(m_outputFrame)) {
+            computeFrame(output + writtenFrames * m_channelsCount);
+            ++writtenFrames;
+            ++m_outputFrame;
+            continue;
+        }
+
+        if (inputFramesUsed == inputFrames) {
+            break;
+        }
+
+        pushFrame(input + inputFramesUsed * m_channelsCount);
+        ++inputFramesUsed;
+    }
+
+    return writtenFrames;
+}
+
+void PolyphaseResampler::pushFrame(const float* frame)
+{
+    for (unsigned int channel = 0; channel < m_channelsCount; ++channel) {
+        float* history = &m_history[static_cast<size_t>(channel) * m_tapsCount * 2];
+        history[m_historyPos] = frame[channel];
+        history[m_historyPos + m_tapsCount] = frame[channel];
+    }
+
+    m_historyPos = (m_historyPos + 1) % m_tapsCount;
+    ++m_inputFrame;
+}
+
+void PolyphaseResampler::computeFrame(float* output) const
+{
+    uint64_t fraction = inputPosition(m_outputFrame) % m_L;
+
+    if (m_phasesCount == m_L) {
+        const float* coefficients = &m_filterBank[fraction * m_tapsCount];
+
+        for (unsigned int channel = 0; channel < m_channelsCount; ++channel) {
+            const float* history = &m_history[static_cast<size_t>(channel) * m_tapsCount * 2 + m_historyPos];
+            output[channel] = dotProduct(history, coefficients, m_tapsCount);
+        }
+
+        return;
+    }
+
+    //! NOTE The position falls between two phases of the bank, interpolate between their outputs
+    uint64_t scaledFraction = fraction * m_phasesCount;
+    uint64_t phase = scaledFraction / m_L;
+    float weight = static_cast<float>(scaledFraction % m_L) / static_cast<float>(m_L);
+
+    const float* coefficients = &m_filterBank[phase * m_tapsCount];
+    const float* nextCoefficients = coefficients + m_tapsCount;
+
+    for (unsigned int channel = 0; channel < m_channelsCount; ++channel) {
+        const float* history = &m_history[static_cast<size_t>(channel) * m_tapsCount * 2 + m_historyPos];
+        float value = dotProduct(history, coefficients, m_tapsCount);
+        float nextValue = dotProduct(history, nextCoefficients, m_tapsCount);
+        output[channel] = value + weight * (nextValue - value);
+    }
+}
+
+uint64_t PolyphaseResampler::inputPosition(uint64_t outputFrame) const
+{
+    return outputFrame * m_M;
+}
+
+uint64_t PolyphaseResampler::requiredInputFrames(uint64_t outputFrame) const
+{
+    //! NOTE The filter is centered on the input position, it needs the half of the taps after it
+    return inputPosition(outputFrame) / m_L + m_tapsCount / 2 + 1 + m_tapsCount;
+}
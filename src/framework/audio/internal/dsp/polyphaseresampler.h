@@ -0,0 +1,77 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_POLYPHASERESAMPLER_H
+#define MU_AUDIO_POLYPHASERESAMPLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mu::audio::dsp {
+//! Streaming band-limited sample rate convertor.
+//! The Kaiser windowed sinc filter is precomputed once as a bank of polyphase sub-filters,
+//! so every output sample costs a single short inner product per channel.
+class PolyphaseResampler
+{
+public:
+    PolyphaseResampler(unsigned int channelsCount, unsigned int sampleRateIn, unsigned int sampleRateOut);
+
+    unsigned int channelsCount() const;
+    unsigned int tapsCount() const;
+
+    //! start a new stream, whose next output frame is the outputFrame-th frame of the converted signal
+    //! return the input frame the stream should be fed from
+    uint64_t reset(uint64_t outputFrame = 0);
+
+    //! convert interleaved input frames into the caller's buffer
+    //! return the number of written output frames, inputFramesUsed receives the number of consumed input frames
+    size_t process(const float* input, size_t inputFrames, size_t& inputFramesUsed, float* output, size_t outputFrames);
+
+private:
+    void initFilterBank(unsigned int sampleRateIn, unsigned int sampleRateOut);
+
+    void pushFrame(const float* frame);
+    void computeFrame(float* output) const;
+
+    uint64_t inputPosition(uint64_t outputFrame) const; // in 1/m_L input frames
+    uint64_t requiredInputFrames(uint64_t outputFrame) const;
+
+    unsigned int m_channelsCount = 0;
+    unsigned int m_tapsCount = 0;
+    unsigned int m_phasesCount = 0;
+
+    uint64_t m_L = 1; //!< interpolation factor
+    uint64_t m_M = 1; //!< decimation factor
+
+    std::vector<float> m_filterBank; //!< (m_phasesCount + 1) sub-filters of m_tapsCount coefficients
+
+    //! last m_tapsCount input frames of each channel, stored twice, so that they are always contiguous
+    std::vector<float> m_history;
+    unsigned int m_historyPos = 0;
+
+    uint64_t m_inputFrame = 0; //!< input frame expected next, the zero padding before the signal included
+    uint64_t m_outputFrame = 0; //!< output frame produced next
+};
+}
+
+#endif // MU_AUDIO_POLYPHASERESAMPLER_H
@@ -0,0 +1,240 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "fileaudiodriver.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+
+#include "log.h"
+#include "runtime.h"
+
+using namespace mu::audio;
+
+static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+static const uint16_t WAV_FORMAT_IEEE_FLOAT = 3;
+
+static uint64_t fnvHash(uint64_t hash, const void* data, size_t bytes)
+{
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < bytes; ++i) {
+        hash ^= p[i];
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+FileAudioDriver::FileAudioDriver(const io::path& filePath)
+    : m_filePath(filePath)
+{
+}
+
+FileAudioDriver::~FileAudioDriver()
+{
+    if (isOpened()) {
+        close();
+    }
+}
+
+std::string FileAudioDriver::name() const
+{
+    return "MUAUDIO(File)";
+}
+
+bool FileAudioDriver::open(const Spec& spec, Spec* activeSpec)
+{
+    IF_ASSERT_FAILED(!isOpened()) {
+        return false;
+    }
+
+    m_file.open(m_filePath.toStdString(), std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open()) {
+        LOGE() << "failed open file: " << m_filePath;
+        return false;
+    }
+
+    m_spec = spec;
+    m_spec.format = Format::AudioF32;
+
+    if (activeSpec) {
+        *activeSpec = m_spec;
+    }
+
+    m_buffer.resize(m_spec.samples * m_spec.channels, 0.f);
+    m_renderedFrames = 0;
+    m_soundHash = FNV_OFFSET_BASIS;
+    m_soundSamples = 0;
+    m_pendingSilentSamples = 0;
+
+    writeWavHeader(0);
+
+    m_running = true;
+    m_thread = std::make_unique<std::thread>([this]() {
+        run();
+    });
+
+    return true;
+}
+
+void FileAudioDriver::close()
+{
+    m_running = false;
+    if (m_thread) {
+        m_thread->join();
+        m_thread = nullptr;
+    }
+
+    if (!m_file.is_open()) {
+        return;
+    }
+
+    uint64_t dataBytes = m_renderedFrames * m_spec.channels * sizeof(float);
+    m_file.seekp(0);
+    writeWavHeader(static_cast<uint32_t>(std::min<uint64_t>(dataBytes, UINT32_MAX - 36)));
+    m_file.close();
+
+    LOGI() << "rendered " << m_renderedFrames << " frames to " << m_filePath
+           << ", sound: " << m_soundSamples / m_spec.channels << " frames, hash: " << std::hex << std::setw(16) << std::setfill('0') << m_soundHash;
+}
+
+bool FileAudioDriver::isOpened() const
+{
+    return m_running;
+}
+
+std::string FileAudioDriver::outputDevice() const
+{
+    return m_filePath.toStdString();
+}
+
+bool FileAudioDriver::selectOutputDevice(const std::string& name)
+{
+    return name == outputDevice();
+}
+
+std::vector<std::string> FileAudioDriver::availableOutputDevices() const
+{
+    return { outputDevice() };
+}
+
+mu::async::Notification FileAudioDriver::availableOutputDevicesChanged() const
+{
+    return async::Notification();
+}
+
+void FileAudioDriver::resume()
+{
+    m_suspended = false;
+}
+
+void FileAudioDriver::suspend()
+{
+    m_suspended = true;
+}
+
+void FileAudioDriver::run()
+{
+    mu::runtime::setThreadName("audio_driver");
+
+    using Clock = std::chrono::steady_clock;
+    const auto blockDuration = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(static_cast<double>(m_spec.samples) / m_spec.sampleRate));
+
+    Clock::time_point nextBlockTime = Clock::now();
+
+    while (m_running) {
+        std::this_thread::sleep_until(nextBlockTime);
+        nextBlockTime += blockDuration;
+
+        if (m_suspended) {
+            continue;
+        }
+
+        m_spec.callback(m_spec.userdata, reinterpret_cast<uint8_t*>(m_buffer.data()),
+                        static_cast<int>(m_buffer.size() * sizeof(float)));
+
+        writeBlock();
+        hashBlock();
+
+        m_renderedFrames += m_spec.samples;
+    }
+}
+
+void FileAudioDriver::writeBlock()
+{
+    m_file.write(reinterpret_cast<const char*>(m_buffer.data()), m_buffer.size() * sizeof(float));
+}
+
+void FileAudioDriver::hashBlock()
+{
+    //! NOTE The playback starts and stops asynchronously, so the silence before and after the sound
+    //! depends on the timing. Only the span from the first to the last non-silent sample is hashed
+    static const float ZERO = 0.f;
+
+    for (float sample : m_buffer) {
+        if (sample == 0.f) {
+            m_pendingSilentSamples++;
+            continue;
+        }
+
+        if (m_soundSamples > 0) {
+            for (uint64_t i = 0; i < m_pendingSilentSamples; ++i) {
+                m_soundHash = fnvHash(m_soundHash, &ZERO, sizeof(float));
+            }
+            m_soundSamples += m_pendingSilentSamples;
+        }
+
+        m_pendingSilentSamples = 0;
+        m_soundHash = fnvHash(m_soundHash, &sample, sizeof(float));
+        m_soundSamples++;
+    }
+}
+
+void FileAudioDriver::writeWavHeader(uint32_t dataBytes)
+{
+    auto writeU32 = [this](uint32_t v) { m_file.write(reinterpret_cast<const char*>(&v), sizeof(v)); };
+    auto writeU16 = [this](uint16_t v) { m_file.write(reinterpret_cast<const char*>(&v), sizeof(v)); };
+
+    uint16_t channels = m_spec.channels;
+    uint32_t sampleRate = static_cast<uint32_t>(m_spec.sampleRate);
+    uint16_t blockAlign = channels * sizeof(float);
+
+    m_file.write("RIFF", 4);
+    writeU32(36 + dataBytes);
+    m_file.write("WAVE", 4);
+
+    m_file.write("fmt ", 4);
+    writeU32(16);
+    writeU16(WAV_FORMAT_IEEE_FLOAT);
+    writeU16(channels);
+    writeU32(sampleRate);
+    writeU32(sampleRate * blockAlign);
+    writeU16(blockAlign);
+    writeU16(sizeof(float) * 8);
+
+    m_file.write("data", 4);
+    writeU32(dataBytes);
+}
@@ -0,0 +1,81 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_FILEAUDIODRIVER_H
+#define MU_AUDIO_FILEAUDIODRIVER_H
+
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "io/path.h"
+
+#include "iaudiodriver.h"
+
+namespace mu::audio {
+//! NOTE Renders the audio to a file instead of an audio device, for example on the machines without sound hardware.
+//! The blocks are pulled at the pace of a real device, so the worker behaves the same way as during the playback.
+//! The hash of the rendered sound, without the silence around it, allows comparing the renders of different builds
+class FileAudioDriver : public IAudioDriver
+{
+public:
+    explicit FileAudioDriver(const io::path& filePath);
+    ~FileAudioDriver() override;
+
+    std::string name() const override;
+    bool open(const Spec& spec, Spec* activeSpec) override;
+    void close() override;
+    bool isOpened() const override;
+
+    std::string outputDevice() const override;
+    bool selectOutputDevice(const std::string& name) override;
+    std::vector<std::string> availableOutputDevices() const override;
+    async::Notification availableOutputDevicesChanged() const override;
+
+    void resume() override;
+    void suspend() override;
+
+private:
+    void run();
+    void writeBlock();
+    void hashBlock();
+    void writeWavHeader(uint32_t dataBytes);
+
+    io::path m_filePath;
+    Spec m_spec;
+    std::ofstream m_file;
+    std::vector<float> m_buffer;
+
+    std::unique_ptr<std::thread> m_thread;
+    std::atomic<bool> m_running = false;
+    std::atomic<bool> m_suspended = false;
+
+    uint64_t m_renderedFrames = 0;
+    uint64_t m_soundHash = 0;
+    uint64_t m_soundSamples = 0;
+    uint64_t m_pendingSilentSamples = 0;
+};
+}
+
+#endif // MU_AUDIO_FILEAUDIODRIVER_H
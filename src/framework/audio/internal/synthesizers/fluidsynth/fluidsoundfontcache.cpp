@@ -0,0 +1,127 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "fluidsoundfontcache.h"
+
+#include <fluidsynth.h>
+#include "fluid_sfont.h"
+#include "fluid_defsfont.h"
+
+#include "internal/audiosanitizer.h"
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::audio::synth;
+
+FluidSoundFontCache::FluidSoundFontCache()
+{
+    m_settings = new_fluid_settings();
+    fluid_settings_setint(m_settings, "synth.lock-memory", 0);
+    fluid_settings_setint(m_settings, "synth.dynamic-sample-loading", 1);
+
+    m_loader = new_fluid_defsfloader(m_settings);
+}
+
+FluidSoundFontCache::~FluidSoundFontCache()
+{
+    //! NOTE The soundfonts use the file callbacks of the loader,
+    //! it can't be deleted while any of them is still alive
+    for (const auto& pair : m_soundFonts) {
+        if (!pair.second.expired()) {
+            return;
+        }
+    }
+
+    delete_fluid_sfloader(m_loader);
+    delete_fluid_settings(m_settings);
+}
+
+FluidSoundFontCache* FluidSoundFontCache::instance()
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    static FluidSoundFontCache c;
+    return &c;
+}
+
+FluidSoundFontCache::SoundFontPtr FluidSoundFontCache::soundFont(const io::path& path)
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    auto search = m_soundFonts.find(path);
+    if (search != m_soundFonts.end()) {
+        if (SoundFontPtr soundFont = search->second.lock()) {
+            return soundFont;
+        }
+    }
+
+    fluid_sfont_t* sfont = fluid_sfloader_load(m_loader, path.c_str());
+    if (!sfont) {
+        return nullptr;
+    }
+
+    //! NOTE The reference of the cache, fluid deletes a soundfont when its reference count drops to zero,
+    //! so none of the synths deletes it while the cache holds it
+    sfont->refcount++;
+
+    //! NOTE Every synth finds its soundfonts by this id, it has to be unique among all the loaded soundfonts
+    sfont->id = ++m_lastSoundFontId;
+
+    SoundFontPtr soundFont(sfont, [](fluid_sfont_t* sfont) {
+        sfont->refcount--;
+
+        if (sfont->refcount != 0 || fluid_sfont_delete_internal(sfont) != 0) {
+            LOGE() << "soundfont is still in use, can't unload it";
+        }
+    });
+
+    m_soundFonts[path] = soundFont;
+
+    return soundFont;
+}
+
+size_t FluidSoundFontCache::loadedSamplesBytes(const SoundFontPtr& soundFont)
+{
+    const fluid_defsfont_t* defsfont = static_cast<const fluid_defsfont_t*>(fluid_sfont_get_data(soundFont.get()));
+    if (!defsfont) {
+        return 0;
+    }
+
+    // all the samples are loaded at once
+    if (defsfont->sampledata) {
+        return defsfont->samplesize + (defsfont->sample24data ? defsfont->sample24size : 0);
+    }
+
+    size_t bytes = 0;
+    for (fluid_list_t* list = defsfont->sample; list; list = fluid_list_next(list)) {
+        const fluid_sample_t* sample = static_cast<const fluid_sample_t*>(fluid_list_get(list));
+        if (!sample->data) {
+            continue;
+        }
+
+        size_t count = sample->end - sample->start + 1;
+        bytes += count * sizeof(short) + (sample->data24 ? count : 0);
+    }
+
+    return bytes;
+}
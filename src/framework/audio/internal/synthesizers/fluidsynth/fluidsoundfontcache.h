@@ -0,0 +1,63 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MU_AUDIO_FLUIDSOUNDFONTCACHE_H
+#define MU_AUDIO_FLUIDSOUNDFONTCACHE_H
+
+#include <map>
+#include <memory>
+
+#include "io/path.h"
+
+typedef struct _fluid_hashtable_t fluid_settings_t;
+typedef struct _fluid_sfloader_t fluid_sfloader_t;
+typedef struct _fluid_sfont_t fluid_sfont_t;
+
+namespace mu::audio::synth {
+//! NOTE Every track has its own synth, but a soundfont is loaded only once per process
+//! and shared by all the synths using it, with its presets, instruments and samples.
+//! It is unloaded when the last synth releases it.
+class FluidSoundFontCache
+{
+public:
+    ~FluidSoundFontCache();
+
+    static FluidSoundFontCache* instance();
+
+    using SoundFontPtr = std::shared_ptr<fluid_sfont_t>;
+
+    SoundFontPtr soundFont(const io::path& path);
+
+    static size_t loadedSamplesBytes(const SoundFontPtr& soundFont);
+
+private:
+    FluidSoundFontCache();
+
+    fluid_settings_t* m_settings = nullptr;
+    fluid_sfloader_t* m_loader = nullptr;
+
+    std::map<io::path, std::weak_ptr<fluid_sfont_t> > m_soundFonts;
+    int m_lastSoundFontId = 0;
+};
+}
+
+#endif // MU_AUDIO_FLUIDSOUNDFONTCACHE_H
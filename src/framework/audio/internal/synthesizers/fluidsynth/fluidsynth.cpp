@@ -26,8 +26,10 @@
 #include <sstream>
 #include <algorithm>
 #include <cmath>
+#include <chrono>
 
 #include <fluidsynth.h>
+#include "fluid_sfont.h"
 
 #include "log.h"
 #include "audioerrors.h"
@@ -45,10 +47,31 @@ static const double FLUID_GLOBAL_VOLUME_GAIN { 1.8 };
 /// @see https://www.fluidsynth.org/api/settings_synth.html
 static const audioch_t FLUID_AUDIO_CHANNELS_PAIR = 1;
 
+//! NOTE The synths are rendered one after another within the same audio callback,
+//! so all of them share its time. When they take more than MAX_RENDER_LOAD of it,
+//! the heaviest synths lower their quality step by step: first the interpolation,
+//! then the polyphony
+static const double MAX_RENDER_LOAD { 0.6 };
+static const double RESTORE_RENDER_LOAD { 0.3 };
+static const samples_t RENDER_LOAD_WINDOW_SAMPLES { 2048 };
+static const int RESTORE_QUALITY_WINDOWS_COUNT { 40 };
+static const int LOWEST_RENDER_QUALITY { 4 };
+static const int MIN_POLYPHONY { 32 };
+
+struct RenderLoadBudget {
+    double totalLoad = 0.0;
+    size_t synthsCount = 0;
+};
+
+static RenderLoadBudget s_renderLoadBudget;
+
 struct mu::audio::synth::Fluid {
     fluid_settings_t* settings = nullptr;
     fluid_synth_t* synth = nullptr;
 
+    //! NOTE Preallocated for the voices lookup on the audio thread
+    std::vector<fluid_voice_t*> voices;
+
     ~Fluid()
     {
         delete_fluid_synth(synth);
@@ -62,6 +85,23 @@ FluidSynth::FluidSynth(const AudioSourceParams& params)
     m_fluid = std::make_shared<Fluid>();
 }
 
+FluidSynth::~FluidSynth()
+{
+    //! NOTE The soundfonts are shared by the synths, the synth must not delete them.
+    //! Deleting the synth stops its voices, after that the soundfonts can be released
+    setIsRenderLoadCounted(false);
+
+    if (m_fluid->synth && !removeSoundFonts()) {
+        //! NOTE Deleting the synth would delete the soundfonts left in its list, the other synths still use them.
+        //! Leak the synth instead, the soundfonts keep its references and are never unloaded
+        LOGE() << "failed remove soundfonts, the synth is not deleted";
+        m_fluid->synth = nullptr;
+    }
+
+    m_fluid = nullptr;
+    m_removedSoundFonts.clear();
+}
+
 bool FluidSynth::isValid() const
 {
     return !m_soundFonts.empty();
@@ -164,6 +204,10 @@ Ret FluidSynth::init()
 
     m_fluid->synth = new_fluid_synth(m_fluid->settings);
 
+    m_maxPolyphony = fluid_synth_get_polyphony(m_fluid->synth);
+    m_load.polyphony = m_maxPolyphony;
+    m_fluid->voices.resize(m_maxPolyphony);
+
     LOGD() << "synth inited\n";
     return true;
 }
@@ -183,22 +227,45 @@ Ret FluidSynth::addSoundFonts(const std::vector<io::path>& sfonts)
         return make_ret(Err::SynthNotInited);
     }
 
+    auto startTime = std::chrono::steady_clock::now();
+
     bool ok = true;
     for (const io::path& sfont : sfonts) {
-        SoundFont sf;
-        sf.id = fluid_synth_sfload(m_fluid->synth, sfont.c_str(), 0);
-        if (sf.id == FLUID_FAILED) {
+        FluidSoundFontCache::SoundFontPtr sharedSoundFont = FluidSoundFontCache::instance()->soundFont(sfont);
+        if (!sharedSoundFont) {
             LOGE() << "failed load soundfont: " << sfont;
             ok = false;
             continue;
         }
 
+        //! NOTE fluid_synth_add_sfont() gives the soundfont the next id of this synth, but the soundfont is shared,
+        //! restore the id from the cache, so that every synth finds it by the same id
+        const int sharedId = sharedSoundFont->id;
+        int ret = fluid_synth_add_sfont(m_fluid->synth, sharedSoundFont.get());
+        sharedSoundFont->id = sharedId;
+
+        if (ret == FLUID_FAILED) {
+            LOGE() << "failed add soundfont: " << sfont;
+            ok = false;
+            continue;
+        }
+
+        //! NOTE The reference of the synth's soundfont list, like fluid_synth_sfload() does
+        sharedSoundFont->refcount++;
+
+        SoundFont sf;
         sf.path = sfont;
+        sf.sfont = std::move(sharedSoundFont);
         m_soundFonts.push_back(std::move(sf));
 
-        LOGI() << "success load soundfont: " << sfont;
+        LOGI() << "success load soundfont: " << sfont << ", shared by " << m_soundFonts.back().sfont.use_count() - 1 << " synths";
     }
 
+    //! NOTE Adding has assigned the presets by the ids of this synth, assign them again by the restored ones
+    fluid_synth_program_reset(m_fluid->synth);
+
+    m_soundFontsLoadingMsecs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
     return ok ? make_ret(Err::NoError) : make_ret(Err::SoundFontFailedLoad);
 }
 
@@ -212,16 +279,22 @@ Ret FluidSynth::removeSoundFonts()
         return make_ret(Err::NoError);
     }
 
+    //! NOTE A soundfont that failed to be removed stays in the list of the synth, keep its reference as well
     bool ok = true;
-    for (const SoundFont& sf : m_soundFonts) {
-        int ret = fluid_synth_sfunload(m_fluid->synth, sf.id, true);
+    auto it = m_soundFonts.begin();
+    while (it != m_soundFonts.end()) {
+        int ret = fluid_synth_remove_sfont(m_fluid->synth, it->sfont.get());
         if (ret == FLUID_FAILED) {
-            LOGE() << "failed remove soundfont id: " << sf.id << ", path: " << sf.path;
+            LOGE() << "failed remove soundfont: " << it->path;
             ok = false;
+            ++it;
+            continue;
         }
-    }
 
-    m_soundFonts.clear();
+        it->sfont->refcount--;
+        m_removedSoundFonts.push_back(std::move(it->sfont));
+        it = m_soundFonts.erase(it);
+    }
 
     return ok ? make_ret(Err::NoError) : make_ret(Err::SoundFontFailedUnload);
 }
@@ -237,6 +310,8 @@ Ret FluidSynth::setupMidiChannels(const std::vector<Event>& events)
         return make_ret(Err::NoLoadedSoundFonts);
     }
 
+    auto startTime = std::chrono::steady_clock::now();
+
     fluid_synth_program_reset(m_fluid->synth);
     fluid_synth_system_reset(m_fluid->synth);
 
@@ -254,9 +329,32 @@ Ret FluidSynth::setupMidiChannels(const std::vector<Event>& events)
         handleEvent(e);
     }
 
+    //! NOTE The samples of the selected programs are loaded now, unless another synth has already loaded them
+    double setupMsecs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+    size_t samplesBytes = 0;
+    for (const SoundFont& sf : m_soundFonts) {
+        samplesBytes += FluidSoundFontCache::loadedSamplesBytes(sf.sfont);
+    }
+
+    LOGI() << "synth ready in " << m_soundFontsLoadingMsecs + setupMsecs << " ms"
+           << " (soundfonts: " << m_soundFontsLoadingMsecs << " ms, channels: " << setupMsecs << " ms)"
+           << ", shared samples in memory: " << samplesBytes / 1024 << " KB";
+
     return make_ret(Err::NoError);
 }
 
+bool FluidSynth::isEventSampleOffsetSupported() const
+{
+    return false;
+}
+
+bool FluidSynth::handleEvent(const Event& e, samples_t sampleOffset)
+{
+    UNUSED(sampleOffset);
+    return handleEvent(e);
+}
+
 bool FluidSynth::handleEvent(const Event& e)
 {
     //! NOTE special midi events are mapped to internal controller
@@ -279,6 +377,10 @@ bool FluidSynth::handleEvent(const Event& e)
     int ret = FLUID_OK;
     switch (e.opcode()) {
     case Event::Opcode::NoteOn: {
+        if (fluid_synth_get_active_voice_count(m_fluid->synth) >= static_cast<int>(m_load.polyphony)) {
+            releaseOldestVoice();
+        }
+
         ret = fluid_synth_noteon(m_fluid->synth, e.channel(), e.note(), e.velocity());
     } break;
     case Event::Opcode::NoteOff: {
@@ -393,6 +495,7 @@ bool FluidSynth::isActive() const
 void FluidSynth::setIsActive(bool arg)
 {
     m_isActive = arg;
+    setIsRenderLoadCounted(arg);
 }
 
 unsigned int FluidSynth::audioChannelsCount() const
@@ -406,10 +509,14 @@ samples_t FluidSynth::process(float* buffer, samples_t samplesPerChannel)
         return 0;
     }
 
+    auto startTime = std::chrono::steady_clock::now();
+
     int result = fluid_synth_write_float(m_fluid->synth, samplesPerChannel,
                                          buffer, 0, audioChannelsCount(),
                                          buffer, 1, audioChannelsCount());
 
+    updateRenderLoad(std::chrono::steady_clock::now() - startTime, samplesPerChannel);
+
     if (result != FLUID_OK) {
         return 0;
     }
@@ -421,3 +528,122 @@ async::Channel<unsigned int> FluidSynth::audioChannelsCountChanged() const
 {
     return m_streamsCountChanged;
 }
+
+async::Channel<SynthesizerLoad> FluidSynth::loadChanged() const
+{
+    return m_loadChanged;
+}
+
+void FluidSynth::updateRenderLoad(std::chrono::steady_clock::duration renderTime, samples_t samplesPerChannel)
+{
+    m_renderLoad.renderTime += renderTime;
+    m_renderLoad.renderedSamples += samplesPerChannel;
+
+    if (m_renderLoad.renderedSamples < RENDER_LOAD_WINDOW_SAMPLES || m_sampleRate == 0) {
+        return;
+    }
+
+    double windowSecs = static_cast<double>(m_renderLoad.renderedSamples) / m_sampleRate;
+    double load = std::chrono::duration<double>(m_renderLoad.renderTime).count() / windowSecs;
+
+    m_renderLoad.renderTime = std::chrono::steady_clock::duration::zero();
+    m_renderLoad.renderedSamples = 0;
+
+    RenderLoadBudget& budget = s_renderLoadBudget;
+    if (m_renderLoad.isCounted) {
+        budget.totalLoad = std::max(0.0, budget.totalLoad + load - m_renderLoad.load);
+    }
+
+    m_renderLoad.load = load;
+
+    double fairLoad = budget.totalLoad / std::max(budget.synthsCount, size_t(1));
+
+    if (budget.totalLoad > MAX_RENDER_LOAD && load >= fairLoad) {
+        m_load.overruns++;
+        m_renderLoad.calmWindowsCount = 0;
+
+        if (m_renderLoad.quality < LOWEST_RENDER_QUALITY) {
+            setRenderQuality(m_renderLoad.quality + 1);
+        }
+    } else if (budget.totalLoad < RESTORE_RENDER_LOAD && m_renderLoad.quality > 0) {
+        if (++m_renderLoad.calmWindowsCount >= RESTORE_QUALITY_WINDOWS_COUNT) {
+            m_renderLoad.calmWindowsCount = 0;
+            setRenderQuality(m_renderLoad.quality - 1);
+        }
+    } else {
+        m_renderLoad.calmWindowsCount = 0;
+    }
+
+    SynthesizerLoad currentLoad = m_load;
+    currentLoad.activeVoices = static_cast<unsigned int>(fluid_synth_get_active_voice_count(m_fluid->synth));
+    currentLoad.renderLoad = std::round(static_cast<float>(load) * 100.f) / 100.f;
+
+    if (currentLoad != m_load) {
+        m_load = currentLoad;
+        m_loadChanged.send(m_load);
+    }
+}
+
+void FluidSynth::setRenderQuality(int quality)
+{
+    m_renderLoad.quality = quality;
+
+    int interpolation = quality > 0 ? FLUID_INTERP_LINEAR : FLUID_INTERP_DEFAULT;
+    fluid_synth_set_interp_method(m_fluid->synth, -1, interpolation);
+
+    //! NOTE fluid_synth_set_polyphony() reallocates the voices and cuts the ones above the limit,
+    //! so fluid keeps its polyphony and the lowered one is kept by releaseOldestVoice() on note on
+    int polyphony = m_maxPolyphony >> std::max(0, quality - 1);
+    polyphony = std::min(m_maxPolyphony, std::max(MIN_POLYPHONY, polyphony));
+
+    m_load.polyphony = static_cast<unsigned int>(polyphony);
+}
+
+void FluidSynth::releaseOldestVoice()
+{
+    std::vector<fluid_voice_t*>& voices = m_fluid->voices;
+    fluid_synth_get_voicelist(m_fluid->synth, voices.data(), static_cast<int>(voices.size()), -1);
+
+    fluid_voice_t* oldestVoice = nullptr;
+    for (fluid_voice_t* voice : voices) {
+        if (!voice) {
+            break;
+        }
+
+        //! NOTE The voices which are already released or held by the sustain are fading out anyway
+        if (!fluid_voice_is_on(voice)) {
+            continue;
+        }
+
+        if (!oldestVoice || fluid_voice_get_id(voice) < fluid_voice_get_id(oldestVoice)) {
+            oldestVoice = voice;
+        }
+    }
+
+    if (!oldestVoice) {
+        return;
+    }
+
+    //! NOTE The note is released rather than cut, so it fades out as usual instead of clicking
+    fluid_synth_noteoff(m_fluid->synth, fluid_voice_get_channel(oldestVoice), fluid_voice_get_key(oldestVoice));
+    m_load.stolenVoices++;
+}
+
+void FluidSynth::setIsRenderLoadCounted(bool counted)
+{
+    if (m_renderLoad.isCounted == counted) {
+        return;
+    }
+
+    m_renderLoad.isCounted = counted;
+
+    RenderLoadBudget& budget = s_renderLoadBudget;
+    if (counted) {
+        budget.synthsCount++;
+        budget.totalLoad += m_renderLoad.load;
+        return;
+    }
+
+    budget.synthsCount--;
+    budget.totalLoad = std::max(0.0, budget.totalLoad - m_renderLoad.load);
+}
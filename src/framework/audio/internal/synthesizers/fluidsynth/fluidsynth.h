@@ -27,10 +27,12 @@
 #include <vector>
 #include <cstdint>
 #include <functional>
+#include <chrono>
 
 #include "modularity/ioc.h"
 
 #include "isynthesizer.h"
+#include "fluidsoundfontcache.h"
 
 namespace mu::audio::synth {
 struct Fluid;
@@ -38,6 +40,7 @@ class FluidSynth : public ISynthesizer
 {
 public:
     FluidSynth(const audio::AudioSourceParams& params);
+    ~FluidSynth() override;
 
     bool isValid() const override;
 
@@ -57,6 +60,8 @@ public:
 
     Ret setupMidiChannels(const std::vector<midi::Event>& events) override;
     bool handleEvent(const midi::Event& e) override;
+    bool isEventSampleOffsetSupported() const override;
+    bool handleEvent(const midi::Event& e, samples_t sampleOffset) override;
 
     void allSoundsOff() override; // all channels
     void flushSound() override;
@@ -66,6 +71,8 @@ public:
     bool midiChannelBalance(midi::channel_t chan, float val) override; // -1. - 1.
     bool midiChannelPitch(midi::channel_t chan, int16_t pitch) override; // -12 - 12
 
+    async::Channel<audio::SynthesizerLoad> loadChanged() const override;
+
     unsigned int audioChannelsCount() const override;
     samples_t process(float* buffer, samples_t samplesPerChannel) override;
     async::Channel<unsigned int> audioChannelsCountChanged() const override;
@@ -80,16 +87,44 @@ private:
         PAN_MSB         = 0x0A
     };
 
+    void updateRenderLoad(std::chrono::steady_clock::duration renderTime, samples_t samplesPerChannel);
+    void setRenderQuality(int quality);
+    void releaseOldestVoice();
+    void setIsRenderLoadCounted(bool counted);
+
     struct SoundFont {
-        int id = -1;
         io::path path;
+        FluidSoundFontCache::SoundFontPtr sfont;
     };
 
     std::shared_ptr<Fluid> m_fluid = nullptr;
     std::vector<SoundFont> m_soundFonts;
 
+    //! NOTE Removed soundfonts might still be used by the playing voices,
+    //! they are released after the synth is deleted
+    std::vector<FluidSoundFontCache::SoundFontPtr> m_removedSoundFonts;
+
+    double m_soundFontsLoadingMsecs = 0.0;
+
     bool m_isLoggingSynthEvents = false;
 
+    //! NOTE The render time is measured over a window of samples,
+    //! the synth renders short pieces of a block between the events
+    struct RenderLoad {
+        std::chrono::steady_clock::duration renderTime = std::chrono::steady_clock::duration::zero();
+        samples_t renderedSamples = 0;
+        double load = 0.0;
+        int quality = 0;
+        int calmWindowsCount = 0;
+        bool isCounted = false;
+    };
+
+    RenderLoad m_renderLoad;
+    int m_maxPolyphony = 0;
+
+    audio::SynthesizerLoad m_load;
+    async::Channel<audio::SynthesizerLoad> m_loadChanged;
+
     std::vector<float> m_preallocated; // used to flush a sound
     bool m_isActive = false;
 
@@ -64,7 +64,15 @@ ISynthesizerPtr SynthResolver::resolveSynth(const TrackId trackId, const AudioIn
     }
 
     const IResolverPtr& resolver = search->second;
-    return resolver->resolveSynth(trackId, params);
+    ISynthesizerPtr synth = resolver->resolveSynth(trackId, params);
+
+    if (synth) {
+        synth->loadChanged().onReceive(this, [this, trackId](const SynthesizerLoad& load) {
+            m_synthesizersLoadChanges.send(trackId, load);
+        });
+    }
+
+    return synth;
 }
 
 ISynthesizerPtr SynthResolver::resolveDefaultSynth(const TrackId trackId) const
@@ -107,3 +115,10 @@ void SynthResolver::registerResolver(const AudioSourceType type, IResolverPtr re
 
     m_resolvers.insert_or_assign(type, std::move(resolver));
 }
+
+SynthesizerLoadChanges SynthResolver::synthesizersLoadChanges() const
+{
+    ONLY_AUDIO_WORKER_THREAD;
+
+    return m_synthesizersLoadChanges;
+}
@@ -26,11 +26,13 @@
 #include <map>
 #include <mutex>
 
+#include "async/asyncable.h"
+
 #include "synthtypes.h"
 #include "isynthresolver.h"
 
 namespace mu::audio::synth {
-class SynthResolver : public ISynthResolver
+class SynthResolver : public ISynthResolver, public async::Asyncable
 {
 public:
     void init(const AudioInputParams& defaultInputParams) override;
@@ -42,6 +44,8 @@ public:
 
     void registerResolver(const AudioSourceType type, IResolverPtr resolver) override;
 
+    SynthesizerLoadChanges synthesizersLoadChanges() const override;
+
 private:
     using SynthPair = std::pair<audio::AudioResourceId, ISynthesizerPtr>;
 
@@ -49,6 +53,8 @@ private:
 
     std::map<AudioSourceType, IResolverPtr> m_resolvers;
     AudioInputParams m_defaultInputParams;
+
+    SynthesizerLoadChanges m_synthesizersLoadChanges;
 };
 }
 
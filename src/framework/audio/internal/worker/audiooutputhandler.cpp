@@ -165,6 +165,16 @@ Promise<AudioSignalChanges> AudioOutputHandler::masterSignalChanges() const
     }, AudioThread::ID);
 }
 
+Promise<SynthesizerLoadChanges> AudioOutputHandler::synthesizersLoadChanges() const
+{
+    return Promise<SynthesizerLoadChanges>([this](Promise<SynthesizerLoadChanges>::Resolve resolve,
+                                                  Promise<SynthesizerLoadChanges>::Reject /*reject*/) {
+        ONLY_AUDIO_WORKER_THREAD;
+
+        resolve(synthResolver()->synthesizersLoadChanges());
+    }, AudioThread::ID);
+}
+
 std::shared_ptr<Mixer> AudioOutputHandler::mixer() const
 {
     return AudioEngine::instance()->mixer();
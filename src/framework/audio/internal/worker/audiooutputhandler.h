@@ -27,6 +27,7 @@
 #include "async/asyncable.h"
 
 #include "ifxresolver.h"
+#include "isynthresolver.h"
 #include "iaudiooutput.h"
 #include "igettracksequence.h"
 
@@ -35,6 +36,7 @@ class Mixer;
 class AudioOutputHandler : public IAudioOutput, public async::Asyncable
 {
     INJECT(audio, fx::IFxResolver, fxResolver)
+    INJECT(audio, synth::ISynthResolver, synthResolver)
 
 public:
     explicit AudioOutputHandler(IGetTrackSequence* getSequence);
@@ -52,6 +54,8 @@ public:
     async::Promise<AudioSignalChanges> signalChanges(const TrackSequenceId sequenceId, const TrackId trackId) const override;
     async::Promise<AudioSignalChanges> masterSignalChanges() const override;
 
+    async::Promise<SynthesizerLoadChanges> synthesizersLoadChanges() const override;
+
 private:
     std::shared_ptr<Mixer> mixer() const;
     ITrackSequencePtr sequence(const TrackSequenceId id) const;
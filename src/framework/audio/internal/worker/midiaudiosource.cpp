@@ -24,10 +24,13 @@
 
 #include <limits>
 #include <cstring>
+#include <algorithm>
+#include <cmath>
 
 #include "log.h"
 #include "realfn.h"
 #include "internal/audiosanitizer.h"
+#include "internal/audioprofiler.h"
 #include "internal/synthesizers/fluidsynth/fluidsynth.h"
 
 using namespace mu;
@@ -36,6 +39,7 @@ using namespace mu::audio::synth;
 using namespace mu::midi;
 
 static tick_t MINIMAL_REQUIRED_LOOKAHEAD = 480 * 4 * 10; // about 10 measures of 4/4 time signature
+static constexpr size_t MAX_PREFETCHED_RANGES = 64;
 
 MidiAudioSource::MidiAudioSource(const TrackId trackId, const MidiData& midiData)
     : m_trackId(trackId), m_stream(midiData.stream), m_mapping(midiData.mapping)
@@ -50,10 +54,21 @@ MidiAudioSource::MidiAudioSource(const TrackId trackId, const MidiData& midiData
     });
 
     m_stream.mainStream.onReceive(this, [this](Events events, tick_t endTick) {
+        m_hasActiveRequest = false;
+
+        //! NOTE The playback position was moved while the events were being rendered
+        if (m_hasOutdatedRequest) {
+            m_hasOutdatedRequest = false;
+            requestNextEvents(MINIMAL_REQUIRED_LOOKAHEAD);
+            return;
+        }
+
         m_mainStreamEventsBuffer.endTick = std::move(endTick);
         m_mainStreamEventsBuffer.push(std::move(events));
+    });
 
-        m_hasActiveRequest = false;
+    m_stream.prefetchStream.onReceive(this, [this](PrefetchedEventsPtr events) {
+        addPrefetchedEvents(std::move(events));
     });
 
     buildTempoMap();
@@ -65,6 +80,10 @@ MidiAudioSource::~MidiAudioSource()
 {
     m_stream.backgroundStream.resetOnReceive(this);
     m_stream.mainStream.resetOnReceive(this);
+    m_stream.prefetchStream.resetOnReceive(this);
+
+    releasePrefetchedEvents(m_mainStreamEventsBuffer.takePrefetched());
+    addPrefetchedEvents(nullptr);
 }
 
 bool MidiAudioSource::isActive() const
@@ -89,6 +108,9 @@ void MidiAudioSource::setIsActive(const bool active)
     // invalidate cached events when we stop playing
     if (!active) {
         invalidateCaches(m_mainStreamEventsBuffer);
+    } else if (m_seekMetrics.isPending) {
+        // the time spent paused after the seek doesn't count
+        m_seekMetrics.startTime = SeekMetrics::Clock::now();
     }
 
     m_synth->setIsActive(active);
@@ -112,6 +134,7 @@ void MidiAudioSource::invalidateCaches(EventsBuffer& eventsBuffer)
     }
 
     m_synth->flushSound();
+    releasePrefetchedEvents(eventsBuffer.takePrefetched());
     eventsBuffer.reset();
 }
 
@@ -121,7 +144,8 @@ void MidiAudioSource::requestNextEvents(const tick_t nextTicksNumber)
         return;
     }
 
-    if (m_mainStreamEventsBuffer.isEmpty()) {
+    //! NOTE Nothing is loaded ahead of the playback position
+    if (m_mainStreamEventsBuffer.endTick <= m_mainStreamEventsBuffer.currentTick) {
         sendRequestFromTick(m_mainStreamEventsBuffer.currentTick);
         return;
     }
@@ -132,7 +156,8 @@ void MidiAudioSource::requestNextEvents(const tick_t nextTicksNumber)
         return;
     }
 
-    tick_t remainingTicks = m_mainStreamEventsBuffer.endTick - newPositionTick;
+    tick_t remainingTicks = m_mainStreamEventsBuffer.endTick > newPositionTick
+                            ? m_mainStreamEventsBuffer.endTick - newPositionTick : 0;
 
     if (remainingTicks < MINIMAL_REQUIRED_LOOKAHEAD) {
         if (m_mainStreamEventsBuffer.endTick == m_stream.lastTick) {
@@ -151,60 +176,170 @@ void MidiAudioSource::sendRequestFromTick(const tick_t from)
     m_hasActiveRequest = true;
 }
 
-void MidiAudioSource::findAndSendNextEvents(MidiAudioSource::EventsBuffer& eventsBuffer, const tick_t nextTicks)
+void MidiAudioSource::addPrefetchedEvents(PrefetchedEventsPtr events)
 {
-    if (eventsBuffer.isEmpty()) {
+    if (!events) {
+        std::vector<PrefetchedEventsPtr> outdatedEvents;
+        std::swap(outdatedEvents, m_prefetchedEvents);
+
+        for (PrefetchedEventsPtr& outdated : outdatedEvents) {
+            releasePrefetchedEvents(std::move(outdated));
+        }
         return;
     }
 
-    tick_t from = eventsBuffer.currentTick;
-    tick_t to = eventsBuffer.currentTick + nextTicks;
-
-    for (tick_t tick = from; tick <= to; ++tick) {
-        eventsBuffer.currentTick = tick;
+    auto outdatedIt = std::find_if(m_prefetchedEvents.begin(), m_prefetchedEvents.end(), [&events](const PrefetchedEventsPtr& e) {
+        return e->from == events->from;
+    });
 
-        if (!eventsBuffer.hasEventsForTick(tick)) {
-            continue;
-        }
+    if (outdatedIt == m_prefetchedEvents.end() && m_prefetchedEvents.size() >= MAX_PREFETCHED_RANGES) {
+        outdatedIt = m_prefetchedEvents.begin();
+    }
 
-        sendEvents(eventsBuffer.pop());
+    if (outdatedIt != m_prefetchedEvents.end()) {
+        PrefetchedEventsPtr outdated = std::move(*outdatedIt);
+        m_prefetchedEvents.erase(outdatedIt);
+        releasePrefetchedEvents(std::move(outdated));
     }
+
+    m_prefetchedEvents.push_back(std::move(events));
 }
 
-void MidiAudioSource::handleBackgroundStream(const msecs_t nextMsecsNumber)
+bool MidiAudioSource::servePrefetchedEvents(const tick_t tick)
 {
-    tick_t nextTicksNumber = m_backgroundStreamEventsBuffer.currentTick + tickFromMsec(nextMsecsNumber);
+    auto it = std::find_if(m_prefetchedEvents.crbegin(), m_prefetchedEvents.crend(), [tick](const PrefetchedEventsPtr& e) {
+        return e->containsTick(tick);
+    });
 
-    findAndSendNextEvents(m_backgroundStreamEventsBuffer, nextTicksNumber);
+    if (it == m_prefetchedEvents.crend()) {
+        return false;
+    }
+
+    releasePrefetchedEvents(m_mainStreamEventsBuffer.takePrefetched());
+
+    m_mainStreamEventsBuffer.endTick = (*it)->to;
+    m_mainStreamEventsBuffer.setPrefetched(*it, tick);
+
+    return true;
 }
 
-void MidiAudioSource::handleMainStream(const msecs_t nextMsecsNumber)
+void MidiAudioSource::releasePrefetchedEvents(PrefetchedEventsPtr events)
 {
-    if (m_mainStreamEventsBuffer.currentTick == m_stream.lastTick) {
+    if (!events) {
         return;
     }
 
-    tick_t nextTicksNumber = tickFromMsec(nextMsecsNumber);
+    //! NOTE The sender still holds the events, dropping them here never deletes them.
+    //! It is notified to delete them on its own thread, once nothing here holds them
+    events.reset();
+    m_stream.prefetchReleased.notify();
+}
 
-    requestNextEvents(nextTicksNumber);
-    findAndSendNextEvents(m_mainStreamEventsBuffer, nextTicksNumber);
+void MidiAudioSource::startSeekMeasurement(const bool isPrefetched)
+{
+    m_seekMetrics.isPending = true;
+    m_seekMetrics.isPrefetched = isPrefetched;
+    m_seekMetrics.startTime = SeekMetrics::Clock::now();
 }
 
-void MidiAudioSource::handleNextMsecs(const msecs_t nextMsecsNumber)
+void MidiAudioSource::finishSeekMeasurement()
 {
-    ONLY_AUDIO_WORKER_THREAD;
+    m_seekMetrics.isPending = false;
+
+    SeekMetrics::Clock::duration latency = SeekMetrics::Clock::now() - m_seekMetrics.startTime;
+    AudioProfiler::instance()->recordSeek(m_trackId, latency, m_seekMetrics.isPrefetched);
+}
+
+void MidiAudioSource::scheduleNextEvents(MidiAudioSource::EventsBuffer& eventsBuffer, const samples_t samplesPerChannel)
+{
+    samples_t blockStart = eventsBuffer.currentSample;
+    samples_t blockEnd = blockStart + samplesPerChannel;
+
+    while (!eventsBuffer.isEmpty()) {
+        tick_t tick = eventsBuffer.nextTick();
+
+        //! NOTE Events behind the playback position are leftovers of an outdated request
+        if (tick < eventsBuffer.currentTick) {
+            eventsBuffer.pop();
+            continue;
+        }
+
+        samples_t sample = samplesFromTick(tick);
+        if (sample >= blockEnd) {
+            break;
+        }
+
+        samples_t offset = sample > blockStart ? sample - blockStart : 0;
+        m_scheduledEvents.push_back({ offset, eventsBuffer.pop() });
+    }
+
+    eventsBuffer.currentSample = blockEnd;
+    eventsBuffer.currentTick = tickFromSamples(blockEnd);
+}
+
+samples_t MidiAudioSource::renderScheduledEvents(float* buffer, const samples_t samplesPerChannel)
+{
+    //! NOTE Both streams are scheduled into the same block, keep the events in time order
+    std::stable_sort(m_scheduledEvents.begin(), m_scheduledEvents.end(), [](const ScheduledEvents& l, const ScheduledEvents& r) {
+        return l.offset < r.offset;
+    });
+
+    //! NOTE The synth schedules the events within the block itself, the block size stays the same
+    if (m_synth->isEventSampleOffsetSupported()) {
+        for (const ScheduledEvents& scheduled : m_scheduledEvents) {
+            sendEvents(scheduled.events, scheduled.offset);
+        }
+        m_scheduledEvents.clear();
+
+        return m_synth->process(buffer, samplesPerChannel);
+    }
+
+    audioch_t channelsCount = m_synth->audioChannelsCount();
+    samples_t renderedSamples = 0;
+    samples_t processedSamplesCount = 0;
 
-    handleBackgroundStream(nextMsecsNumber);
+    //! NOTE Render the synth in sub-blocks, so that every event takes effect at its own sample
+    for (const ScheduledEvents& scheduled : m_scheduledEvents) {
+        if (scheduled.offset > renderedSamples) {
+            processedSamplesCount += m_synth->process(buffer + renderedSamples * channelsCount, scheduled.offset - renderedSamples);
+            renderedSamples = scheduled.offset;
+        }
+
+        sendEvents(scheduled.events);
+    }
 
-    if (isActive()) {
-        handleMainStream(nextMsecsNumber);
+    if (renderedSamples < samplesPerChannel) {
+        processedSamplesCount += m_synth->process(buffer + renderedSamples * channelsCount, samplesPerChannel - renderedSamples);
     }
+
+    m_scheduledEvents.clear();
+
+    return processedSamplesCount;
+}
+
+void MidiAudioSource::handleMainStream(const samples_t samplesPerChannel)
+{
+    if (m_mainStreamEventsBuffer.currentTick >= m_stream.lastTick) {
+        return;
+    }
+
+    tick_t currentTick = m_mainStreamEventsBuffer.currentTick;
+    tick_t nextTick = tickFromSamples(m_mainStreamEventsBuffer.currentSample + samplesPerChannel);
+
+    requestNextEvents(nextTick > currentTick ? nextTick - currentTick : 0);
+    scheduleNextEvents(m_mainStreamEventsBuffer, samplesPerChannel);
 }
 
 void MidiAudioSource::setSampleRate(unsigned int sampleRate)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
+    if (m_sampleRate != 0 && m_sampleRate != sampleRate) {
+        for (EventsBuffer* eventsBuffer : { &m_mainStreamEventsBuffer, &m_backgroundStreamEventsBuffer }) {
+            eventsBuffer->currentSample = eventsBuffer->currentSample * sampleRate / m_sampleRate;
+        }
+    }
+
     m_sampleRate = sampleRate;
 
     if (!m_synth) {
@@ -240,30 +375,36 @@ samples_t MidiAudioSource::process(float* buffer, samples_t samplesPerChannel)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
-    if (!m_synth) {
+    if (!m_synth || m_sampleRate == 0) {
         return 0;
     }
 
-    samples_t processedSamplesCount = 0;
-    msecs_t nextMsecsNumber = samplesPerChannel * 1000 / m_sampleRate;
+    scheduleNextEvents(m_backgroundStreamEventsBuffer, samplesPerChannel);
+
+    bool active = isActive();
+    if (active) {
+        if (m_seekMetrics.isPending && m_mainStreamEventsBuffer.endTick > m_mainStreamEventsBuffer.currentTick) {
+            finishSeekMeasurement();
+        }
 
-    if (hasAnythingToPlayback(nextMsecsNumber)) {
-        processedSamplesCount = m_synth->process(buffer, samplesPerChannel);
+        handleMainStream(samplesPerChannel);
     }
 
-    handleNextMsecs(nextMsecsNumber);
+    if (!active && m_scheduledEvents.empty() && m_backgroundStreamEventsBuffer.isEmpty()) {
+        return 0;
+    }
 
-    return processedSamplesCount;
+    return renderScheduledEvents(buffer, samplesPerChannel);
 }
 
-bool MidiAudioSource::sendEvents(const std::vector<Event>& events)
+bool MidiAudioSource::sendEvents(const std::vector<Event>& events, samples_t sampleOffset)
 {
     IF_ASSERT_FAILED(m_synth) {
         return false;
     }
 
     for (const Event& event : events) {
-        m_synth->handleEvent(event);
+        m_synth->handleEvent(event, sampleOffset);
         midiOutPort()->sendEvent(event);
     }
 
@@ -275,9 +416,20 @@ void MidiAudioSource::seek(const msecs_t newPositionMsecs)
     ONLY_AUDIO_WORKER_THREAD;
 
     invalidateCaches(m_mainStreamEventsBuffer);
+    m_mainStreamEventsBuffer.currentSample = newPositionMsecs * m_sampleRate / 1000;
     m_mainStreamEventsBuffer.currentTick = tickFromMsec(newPositionMsecs);
 
-    requestNextEvents(MINIMAL_REQUIRED_LOOKAHEAD);
+    if (m_hasActiveRequest) {
+        m_hasOutdatedRequest = true;
+    }
+
+    //! NOTE Prefetched events are played right away, without waiting for them to be rendered
+    bool isPrefetched = servePrefetchedEvents(m_mainStreamEventsBuffer.currentTick);
+    if (!isPrefetched) {
+        requestNextEvents(MINIMAL_REQUIRED_LOOKAHEAD);
+    }
+
+    startSeekMeasurement(isPrefetched);
 }
 
 const AudioInputParams& MidiAudioSource::inputParams() const
@@ -327,7 +479,8 @@ void MidiAudioSource::buildTempoMap()
         tempos.push_back({ 0, 500000 });
     }
 
-    uint64_t msec { 0 };
+    //! NOTE Keep the start times unrounded, so that the rounding errors don't pile up over the tempo changes
+    double msec = 0.0;
     for (size_t i = 0; i < tempos.size(); ++i) {
         TempoItem t;
 
@@ -336,33 +489,51 @@ void MidiAudioSource::buildTempoMap()
         t.startMsec = msec;
         t.onetickMsec = static_cast<double>(t.tempo) / static_cast<double>(m_mapping.division) / 1000.;
 
-        tick_t end_ticks = ((i + 1) < tempos.size()) ? tempos.at(i + 1).first : std::numeric_limits<uint32_t>::max();
-
-        tick_t delta_ticks = end_ticks - t.startTicks;
-        msec += static_cast<msecs_t>(delta_ticks * t.onetickMsec);
+        if ((i + 1) < tempos.size()) {
+            tick_t delta_ticks = tempos.at(i + 1).first - t.startTicks;
+            msec += delta_ticks * t.onetickMsec;
+        }
 
-        m_tempoMap.insert({ msec, std::move(t) });
+        m_tempoMap.push_back(std::move(t));
     }
 }
 
-tick_t MidiAudioSource::tickFromMsec(const msecs_t msec) const
+const MidiAudioSource::TempoItem& MidiAudioSource::tempoItemForTick(const tick_t tick) const
 {
-    auto it = m_tempoMap.lower_bound(msec);
+    auto it = std::upper_bound(m_tempoMap.cbegin(), m_tempoMap.cend(), tick, [](const tick_t tick, const TempoItem& item) {
+        return tick < item.startTicks;
+    });
 
-    const TempoItem& t = it->second;
+    return it == m_tempoMap.cbegin() ? *it : *std::prev(it);
+}
+
+const MidiAudioSource::TempoItem& MidiAudioSource::tempoItemForMsec(const double msec) const
+{
+    auto it = std::upper_bound(m_tempoMap.cbegin(), m_tempoMap.cend(), msec, [](const double msec, const TempoItem& item) {
+        return msec < item.startMsec;
+    });
+
+    return it == m_tempoMap.cbegin() ? *it : *std::prev(it);
+}
 
-    msecs_t delta = msec - t.startMsec;
+tick_t MidiAudioSource::tickFromMsec(const double msec) const
+{
+    const TempoItem& t = tempoItemForMsec(msec);
+
+    double delta = std::max(msec - t.startMsec, 0.0);
     tick_t ticks = static_cast<tick_t>(delta / t.onetickMsec);
     return t.startTicks + ticks;
 }
 
-bool MidiAudioSource::hasAnythingToPlayback(const msecs_t nextMsecsNumber) const
+tick_t MidiAudioSource::tickFromSamples(const samples_t samples) const
 {
-    if (isActive()) {
-        return true;
-    }
+    return tickFromMsec(static_cast<double>(samples) * 1000.0 / static_cast<double>(m_sampleRate));
+}
 
-    tick_t nextTicksNumber = tickFromMsec(nextMsecsNumber);
+samples_t MidiAudioSource::samplesFromTick(const tick_t tick) const
+{
+    const TempoItem& t = tempoItemForTick(tick);
 
-    return m_backgroundStreamEventsBuffer.hasEventsForNextTicks(nextTicksNumber);
+    double msec = t.startMsec + (tick > t.startTicks ? tick - t.startTicks : 0) * t.onetickMsec;
+    return static_cast<samples_t>(std::llround(msec * static_cast<double>(m_sampleRate) / 1000.0));
 }
@@ -28,6 +28,7 @@
 #include <map>
 #include <cstdint>
 #include <functional>
+#include <chrono>
 
 #include "modularity/ioc.h"
 #include "async/asyncable.h"
@@ -68,14 +69,21 @@ private:
         midi::tick_t currentTick = 0;
         midi::tick_t endTick = 0;
 
-        bool hasEventsForTick(const midi::tick_t tick) const
+        //! NOTE Playback position counted in samples, so that it never drifts away from the rendered audio
+        samples_t currentSample = 0;
+
+        midi::tick_t nextTick() const
         {
-            return m_eventsMap.find(tick) != m_eventsMap.end();
+            return isNextPrefetched() ? m_prefetchedIt->first : m_eventsMap.begin()->first;
         }
 
         std::vector<midi::Event> pop()
         {
-            return m_eventsMap.extract(currentTick).mapped();
+            if (isNextPrefetched()) {
+                return (m_prefetchedIt++)->second;
+            }
+
+            return m_eventsMap.extract(m_eventsMap.begin()).mapped();
         }
 
         void push(midi::Events&& newEvents)
@@ -88,56 +96,100 @@ private:
             }
         }
 
-        bool hasEventsForNextTicks(const midi::tick_t nextTicksCount) const
+        //! NOTE The prefetched events are served in place, from the given tick on, instead of being copied
+        void setPrefetched(midi::PrefetchedEventsPtr prefetched, const midi::tick_t fromTick)
         {
-            if (isEmpty()) {
-                return false;
-            }
-
-            for (midi::tick_t tick = currentTick; tick <= currentTick + nextTicksCount; ++tick) {
-                if (hasEventsForTick(tick)) {
-                    return true;
-                }
-            }
+            m_prefetched = std::move(prefetched);
+            m_prefetchedIt = m_prefetched->events.lower_bound(fromTick);
+        }
 
-            return false;
+        midi::PrefetchedEventsPtr takePrefetched()
+        {
+            m_prefetchedIt = midi::Events::const_iterator();
+            return std::move(m_prefetched);
         }
 
         bool isEmpty() const
         {
-            return m_eventsMap.empty();
+            return !hasPrefetched() && m_eventsMap.empty();
         }
 
         void reset()
         {
             currentTick = 0;
             endTick = 0;
+            currentSample = 0;
             m_eventsMap.clear();
         }
 
     private:
+        bool hasPrefetched() const
+        {
+            return m_prefetched && m_prefetchedIt != m_prefetched->events.cend();
+        }
+
+        bool isNextPrefetched() const
+        {
+            return hasPrefetched() && (m_eventsMap.empty() || m_prefetchedIt->first <= m_eventsMap.begin()->first);
+        }
+
         midi::Events m_eventsMap;
+
+        midi::PrefetchedEventsPtr m_prefetched;
+        midi::Events::const_iterator m_prefetchedIt;
+    };
+
+    struct ScheduledEvents {
+        samples_t offset = 0; // from the start of the current block
+        std::vector<midi::Event> events;
     };
 
-    void handleNextMsecs(const msecs_t nextMsecsNumber);
+    struct TempoItem {
+        midi::tempo_t tempo = 500000;
+        midi::tick_t startTicks = 0;
+        double startMsec = 0.0;
+        double onetickMsec = 0.0;
+    };
+
+    //! NOTE Measures how long it takes from a seek (or from the start of the playback after it)
+    //! until the events for the new position are there to be rendered
+    struct SeekMetrics {
+        using Clock = std::chrono::steady_clock;
+
+        bool isPending = false;
+        bool isPrefetched = false;
+        Clock::time_point startTime;
+    };
+
+    const TempoItem& tempoItemForTick(const midi::tick_t tick) const;
+    const TempoItem& tempoItemForMsec(const double msec) const;
 
-    midi::tick_t tickFromMsec(const msecs_t msec) const;
+    midi::tick_t tickFromMsec(const double msec) const;
+    midi::tick_t tickFromSamples(const samples_t samples) const;
+    samples_t samplesFromTick(const midi::tick_t tick) const;
 
-    bool hasAnythingToPlayback(const msecs_t nextMsecsNumber) const;
-    void handleBackgroundStream(const msecs_t nextMsecsNumber);
-    void handleMainStream(const msecs_t nextMsecsNumber);
+    void handleMainStream(const samples_t samplesPerChannel);
 
-    void findAndSendNextEvents(EventsBuffer& eventsBuffer, const midi::tick_t nextTicks);
-    bool sendEvents(const std::vector<midi::Event>& events);
+    void scheduleNextEvents(EventsBuffer& eventsBuffer, const samples_t samplesPerChannel);
+    samples_t renderScheduledEvents(float* buffer, const samples_t samplesPerChannel);
+    bool sendEvents(const std::vector<midi::Event>& events, samples_t sampleOffset = 0);
     void requestNextEvents(const midi::tick_t nextTicksNumber);
     void sendRequestFromTick(const midi::tick_t from);
 
+    void addPrefetchedEvents(midi::PrefetchedEventsPtr events);
+    bool servePrefetchedEvents(const midi::tick_t tick);
+    void releasePrefetchedEvents(midi::PrefetchedEventsPtr events);
+
+    void startSeekMeasurement(const bool isPrefetched);
+    void finishSeekMeasurement();
+
     void buildTempoMap();
     void setupChannels();
 
     void invalidateCaches(EventsBuffer& eventsBuffer);
 
     bool m_hasActiveRequest = false;
+    bool m_hasOutdatedRequest = false;
 
     TrackId m_trackId = -1;
     synth::ISynthesizerPtr m_synth = nullptr;
@@ -150,15 +202,14 @@ private:
     EventsBuffer m_mainStreamEventsBuffer;
     EventsBuffer m_backgroundStreamEventsBuffer;
 
+    std::vector<ScheduledEvents> m_scheduledEvents;
+
+    std::vector<midi::PrefetchedEventsPtr> m_prefetchedEvents;
+    SeekMetrics m_seekMetrics;
+
     unsigned int m_sampleRate = 0;
 
-    struct TempoItem {
-        midi::tempo_t tempo = 500000;
-        midi::tick_t startTicks = 0;
-        uint64_t startMsec = 0;
-        double onetickMsec = 0.0;
-    };
-    std::map<msecs_t /*msec*/, TempoItem> m_tempoMap = {};
+    std::vector<TempoItem> m_tempoMap = {}; // sorted by startTicks (and startMsec)
 };
 }
 
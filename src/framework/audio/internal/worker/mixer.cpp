@@ -28,6 +28,7 @@
 
 #include "internal/audiosanitizer.h"
 #include "internal/audiothread.h"
+#include "internal/audioprofiler.h"
 #include "internal/dsp/audiomathutils.h"
 #include "audioerrors.h"
 
@@ -97,6 +98,7 @@ void Mixer::setSampleRate(unsigned int sampleRate)
     ONLY_AUDIO_WORKER_THREAD;
 
     m_limiter = std::make_unique<dsp::Limiter>(sampleRate);
+    m_clockRemainder = 0;
 
     AbstractAudioSource::setSampleRate(sampleRate);
 
@@ -116,8 +118,15 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
 {
     ONLY_AUDIO_WORKER_THREAD;
 
+    auto blockStartTime = std::chrono::steady_clock::now();
+
+    //! NOTE Carry the sub-millisecond remainder over to the next block, so that the clocks don't drift
+    m_clockRemainder += samplesPerChannel * 1000;
+    msecs_t nextMsecs = m_clockRemainder / m_sampleRate;
+    m_clockRemainder %= m_sampleRate;
+
     for (IClockPtr clock : m_clocks) {
-        clock->forward((samplesPerChannel * 1000) / m_sampleRate);
+        clock->forward(nextMsecs);
     }
 
     std::fill(outBuffer, outBuffer + samplesPerChannel * audioChannelsCount(), 0.f);
@@ -128,8 +137,13 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
 
     samples_t masterChannelSampleCount = 0;
 
+    AudioProfiler* profiler = AudioProfiler::instance();
+
     for (auto& channel : m_mixerChannels) {
+        auto channelStartTime = std::chrono::steady_clock::now();
         samples_t processedSamplesCount = channel.second->process(m_writeCacheBuff.data(), samplesPerChannel);
+        profiler->recordChannel(channel.first, std::chrono::steady_clock::now() - channelStartTime);
+
         mixOutputFromChannel(outBuffer, m_writeCacheBuff.data(), processedSamplesCount);
         std::fill(m_writeCacheBuff.begin(), m_writeCacheBuff.end(), 0.f);
 
@@ -140,17 +154,24 @@ samples_t Mixer::process(float* outBuffer, samples_t samplesPerChannel)
         for (audioch_t audioChNum = 0; audioChNum < audioChannelsCount(); ++audioChNum) {
             notifyAboutAudioSignalChanges(audioChNum, 0);
         }
+
+        profiler->recordBlock(std::chrono::steady_clock::now() - blockStartTime, samplesPerChannel, m_sampleRate);
         return 0;
     }
 
     completeOutput(outBuffer, samplesPerChannel);
 
-    for (IFxProcessorPtr& fxProcessor : m_masterFxProcessors) {
+    for (size_t i = 0; i < m_masterFxProcessors.size(); ++i) {
+        IFxProcessorPtr& fxProcessor = m_masterFxProcessors[i];
         if (fxProcessor->active()) {
+            auto fxStartTime = std::chrono::steady_clock::now();
             fxProcessor->process(outBuffer, samplesPerChannel);
+            profiler->recordMasterFx(i, std::chrono::steady_clock::now() - fxStartTime);
         }
     }
 
+    profiler->recordBlock(std::chrono::steady_clock::now() - blockStartTime, samplesPerChannel, m_sampleRate);
+
     return masterChannelSampleCount;
 }
 
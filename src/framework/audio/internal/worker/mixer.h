@@ -78,6 +78,7 @@ private:
     dsp::LimiterPtr m_limiter = nullptr;
 
     std::set<IClockPtr> m_clocks;
+    samples_t m_clockRemainder = 0; // in samples * 1000
     audioch_t m_audioChannelsCount = 0;
 
     mutable AudioSignalsNotifier m_audioSignalNotifier;
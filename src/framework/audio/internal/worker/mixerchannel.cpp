@@ -27,6 +27,7 @@
 
 #include "internal/dsp/audiomathutils.h"
 #include "internal/audiosanitizer.h"
+#include "internal/audioprofiler.h"
 
 using namespace mu;
 using namespace mu::audio;
@@ -173,11 +174,15 @@ samples_t MixerChannel::process(float* buffer, samples_t samplesPerChannel)
         return processedSamplesCount;
     }
 
-    for (IFxProcessorPtr fx : m_fxProcessors) {
+    for (size_t i = 0; i < m_fxProcessors.size(); ++i) {
+        const IFxProcessorPtr& fx = m_fxProcessors[i];
         if (!fx->active()) {
             continue;
         }
+
+        auto fxStartTime = std::chrono::steady_clock::now();
         fx->process(buffer, samplesPerChannel);
+        AudioProfiler::instance()->recordChannelFx(m_trackId, i, std::chrono::steady_clock::now() - fxStartTime);
     }
 
     completeOutput(buffer, samplesPerChannel);
@@ -23,14 +23,14 @@
 #define MU_AUDIO_SAMPLERATECONVERTOR_H
 
 #include <vector>
-#include <deque>
+#include <memory>
+
+#include "internal/dsp/polyphaseresampler.h"
+
 namespace mu::audio {
 class SampleRateConvertor
 {
 public:
-    enum Method {
-        SINC, FIR
-    };
     explicit SampleRateConvertor(const std::vector<float>& data, unsigned int channelsCount, unsigned int sampleRateIn,
                                  unsigned int sampleRateOut);
 
@@ -45,34 +45,19 @@ public:
     void setSampleRateOut(unsigned int sampleRate);
 
 private:
+    //! return the resampler for the current settings, nullptr if they are invalid
+    dsp::PolyphaseResampler* resampler();
 
-    //! return value of sinc function (LPF) with considaration of used sampleRates
-    double sinc(double value) const;
-
-    //! output sample value
-    float y(unsigned int sample, unsigned int channel) const;
-    float ySinc(unsigned int sample, unsigned int channel) const;
-    float yFIR(unsigned int sample, unsigned int channel) const;
-
-    //! return true if there are samples in input buffer for convertion
-    bool availableSamples(unsigned int sample) const;
-
-    //! calculate window function values
-    void initWindow();
-
-    const static unsigned int USE_SAMPLES = 16; //!< this value defines the quality and complexity of SRC.
     const std::vector<float>& m_data;
 
-    //! values of window function for USE_SAMPLES
-    const static unsigned int FIR_LENGTH = 33;
-    unsigned int m_M = 1, m_L = 1;
-    std::vector<float> m_fir;
-    mutable std::deque<float> m_y;
+    std::unique_ptr<dsp::PolyphaseResampler> m_resampler;
+    std::vector<float> m_silence; //!< fed after the data, for the filter tail
+    uint64_t m_nextInputFrame = 0;
+    uint64_t m_nextOutputFrame = 0; //!< continuing from here doesn't need a reset of the resampler
 
     unsigned int m_channelsCount;
     unsigned int m_sampleRateIn;
     unsigned int m_sampleRateOut;
-    Method m_method = FIR;
 };
 }
 
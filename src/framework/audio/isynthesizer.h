@@ -53,12 +53,19 @@ public:
     virtual Ret setupMidiChannels(const std::vector<midi::Event>& events) = 0;
     virtual bool handleEvent(const midi::Event& e) = 0;
 
+    //! NOTE Synthesizers that support it take the events at a sample offset into the next processed block,
+    //! the others get the block processed in parts, split at the events
+    virtual bool isEventSampleOffsetSupported() const = 0;
+    virtual bool handleEvent(const midi::Event& e, samples_t sampleOffset) = 0;
+
     virtual void allSoundsOff() = 0; // all channels
     virtual void flushSound() = 0;
     virtual void midiChannelSoundsOff(midi::channel_t chan) = 0;
     virtual bool midiChannelVolume(midi::channel_t chan, float val) = 0;  // 0. - 1.
     virtual bool midiChannelBalance(midi::channel_t chan, float val) = 0; // -1. - 1.
     virtual bool midiChannelPitch(midi::channel_t chan, int16_t val) = 0; // -12 - 12
+
+    virtual async::Channel<SynthesizerLoad> loadChanged() const = 0;
 };
 
 using ISynthesizerPtr = std::shared_ptr<ISynthesizer>;
@@ -56,6 +56,8 @@ public:
     virtual AudioInputParams resolveDefaultInputParams() const = 0;
     virtual audio::AudioResourceMetaList resolveAvailableResources() const = 0;
     virtual void registerResolver(const AudioSourceType type, IResolverPtr resolver) = 0;
+
+    virtual SynthesizerLoadChanges synthesizersLoadChanges() const = 0;
 };
 
 using ISynthResolverPtr = std::shared_ptr<ISynthResolver>;
@@ -39,6 +39,18 @@ Rectangle {
         }
     }
 
+    AudioProfilerModel {
+        id: profilerModel
+    }
+
+    Timer {
+        interval: 1000
+        repeat: true
+        running: root.visible
+
+        onTriggered: profilerModel.refresh()
+    }
+
     Rectangle {
         id: backgroundRect
 
@@ -84,4 +96,24 @@ Rectangle {
             currentSignalAmplitude: waveModel.currentSignalAmplitude
         }
     }
+
+    Column {
+        anchors.top: contentRow.bottom
+        anchors.topMargin: 16
+        anchors.left: parent.left
+        anchors.leftMargin: 8
+
+        spacing: 8
+
+        FlatButton {
+            text: "Reset profile"
+            onClicked: profilerModel.reset()
+        }
+
+        StyledTextLabel {
+            text: profilerModel.summary
+            horizontalAlignment: Text.AlignLeft
+            font.family: "monospace"
+        }
+    }
 }
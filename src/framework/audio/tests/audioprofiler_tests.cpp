@@ -0,0 +1,157 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <limits>
+
+#include "internal/audioprofiler.h"
+
+using namespace mu::audio;
+
+class AudioProfilerTests : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        //! NOTE The profiler is shared by the whole process, other tests might have recorded into it
+        profiler()->reset();
+    }
+
+    static AudioProfiler* profiler()
+    {
+        return AudioProfiler::instance();
+    }
+
+    static AudioProfiler::Duration msecs(size_t value)
+    {
+        return std::chrono::milliseconds(value);
+    }
+};
+
+/**
+ * @brief AudioProfilerTests_percentiles
+ * @details Records the values from 1 to 100 ms in reverse order, the percentiles must be the nearest ranks of them
+ */
+TEST_F(AudioProfilerTests, percentiles)
+{
+    for (size_t value = 100; value > 0; --value) {
+        profiler()->recordChannel(1, msecs(value));
+    }
+
+    AudioProfiler::Summary summary = profiler()->summary();
+    ASSERT_EQ(summary.channelMsecs.count(1), 1);
+
+    const AudioProfiler::Stats& stats = summary.channelMsecs.at(1);
+    EXPECT_EQ(stats.count, 100);
+    EXPECT_DOUBLE_EQ(stats.p50, 51.0);
+    EXPECT_DOUBLE_EQ(stats.p95, 95.0);
+    EXPECT_DOUBLE_EQ(stats.p99, 99.0);
+    EXPECT_DOUBLE_EQ(stats.max, 100.0);
+}
+
+/**
+ * @brief AudioProfilerTests_wrapAround
+ * @details Records more than the capacity of the ring, only the latest records must be in the summary
+ */
+TEST_F(AudioProfilerTests, wrapAround)
+{
+    constexpr size_t OVERWRITTEN_COUNT = 100;
+
+    for (size_t value = 1; value <= AudioProfiler::CAPACITY + OVERWRITTEN_COUNT; ++value) {
+        profiler()->recordBufferFill(static_cast<samples_t>(value));
+    }
+
+    const AudioProfiler::Stats stats = profiler()->summary().bufferFillSamples;
+    EXPECT_EQ(stats.count, AudioProfiler::CAPACITY);
+    EXPECT_DOUBLE_EQ(stats.max, static_cast<double>(AudioProfiler::CAPACITY + OVERWRITTEN_COUNT));
+
+    //! NOTE The oldest records left are OVERWRITTEN_COUNT + 1 and on
+    EXPECT_DOUBLE_EQ(stats.p50, static_cast<double>(OVERWRITTEN_COUNT + AudioProfiler::CAPACITY / 2 + 1));
+}
+
+/**
+ * @brief AudioProfilerTests_resetExcludesOlderRecords
+ * @details The records and the xruns from before a reset must not be in the summary
+ */
+TEST_F(AudioProfilerTests, resetExcludesOlderRecords)
+{
+    profiler()->recordSeek(1, msecs(100), false);
+    profiler()->recordSeek(1, msecs(200), true);
+    profiler()->recordXrun();
+
+    profiler()->reset();
+
+    AudioProfiler::Summary summary = profiler()->summary();
+    EXPECT_EQ(summary.seekMsecs.count, 0);
+    EXPECT_EQ(summary.prefetchedSeeks, 0);
+    EXPECT_EQ(summary.xruns, 0);
+
+    profiler()->recordSeek(1, msecs(10), true);
+    profiler()->recordXrun();
+
+    summary = profiler()->summary();
+    EXPECT_EQ(summary.seekMsecs.count, 1);
+    EXPECT_DOUBLE_EQ(summary.seekMsecs.max, 10.0);
+    EXPECT_EQ(summary.prefetchedSeeks, 1);
+    EXPECT_EQ(summary.xruns, 1);
+}
+
+/**
+ * @brief AudioProfilerTests_trackAndFxKeys
+ * @details The track ids and the fx indexes are packed into the keys of the records,
+ *          every one of them must be summarized on its own, under the same track id and fx index
+ */
+TEST_F(AudioProfilerTests, trackAndFxKeys)
+{
+    constexpr TrackId MAX_TRACK_ID = std::numeric_limits<TrackId>::max();
+    constexpr TrackId NEGATIVE_TRACK_ID = -1;
+    constexpr size_t MAX_FX_INDEX = 0xFFFFFF;
+
+    profiler()->recordChannel(0, msecs(1));
+    profiler()->recordChannel(MAX_TRACK_ID, msecs(2));
+    profiler()->recordChannel(NEGATIVE_TRACK_ID, msecs(3));
+
+    profiler()->recordChannelFx(MAX_TRACK_ID, 0, msecs(4));
+    profiler()->recordChannelFx(MAX_TRACK_ID, MAX_FX_INDEX, msecs(5));
+    profiler()->recordChannelFx(NEGATIVE_TRACK_ID, 1, msecs(6));
+
+    profiler()->recordMasterFx(0, msecs(7));
+    profiler()->recordMasterFx(MAX_FX_INDEX, msecs(8));
+
+    AudioProfiler::Summary summary = profiler()->summary();
+
+    ASSERT_EQ(summary.channelMsecs.size(), 3);
+    EXPECT_DOUBLE_EQ(summary.channelMsecs[0].max, 1.0);
+    EXPECT_DOUBLE_EQ(summary.channelMsecs[MAX_TRACK_ID].max, 2.0);
+    EXPECT_DOUBLE_EQ(summary.channelMsecs[NEGATIVE_TRACK_ID].max, 3.0);
+
+    ASSERT_EQ(summary.channelFxMsecs.size(), 3);
+    EXPECT_DOUBLE_EQ((summary.channelFxMsecs[{ MAX_TRACK_ID, 0 }].max), 4.0);
+    EXPECT_DOUBLE_EQ((summary.channelFxMsecs[{ MAX_TRACK_ID, MAX_FX_INDEX }].max), 5.0);
+    EXPECT_DOUBLE_EQ((summary.channelFxMsecs[{ NEGATIVE_TRACK_ID, 1 }].max), 6.0);
+
+    ASSERT_EQ(summary.masterFxMsecs.size(), 2);
+    EXPECT_DOUBLE_EQ(summary.masterFxMsecs[0].max, 7.0);
+    EXPECT_DOUBLE_EQ(summary.masterFxMsecs[MAX_FX_INDEX].max, 8.0);
+}
@@ -0,0 +1,307 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "internal/audiosanitizer.h"
+#include "internal/worker/mixer.h"
+#include "internal/worker/midiaudiosource.h"
+
+#include "mocks/synthresolvermock.h"
+#include "mocks/midioutportmock.h"
+#include "utils/testsynthesizer.h"
+
+#include "log.h"
+
+using ::testing::_;
+using ::testing::NiceMock;
+
+using namespace mu;
+using namespace mu::audio;
+using namespace mu::midi;
+
+static constexpr unsigned int SAMPLE_RATE = 48000;
+static constexpr audioch_t CHANNELS_COUNT = 2;
+static constexpr samples_t BLOCK_SIZE = 512;
+
+static constexpr int DIVISION = 480;
+static constexpr tempo_t TEMPO = 500000; // 120 BPM, a tick is 50 samples long
+
+//! NOTE The hash of the sources of the score below, mixed before the channel and master dynamics.
+//! The compressor and the limiter go through log10 and pow, which aren't bit exact across the math libraries,
+//! so the output of the mixer is only compared with another render on the same machine
+static constexpr uint64_t GOLDEN_HASH = 1038531498318232941ULL;
+
+static constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+static constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+class MixerRenderTests : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        AudioSanitizer::setupWorkerThread();
+    }
+
+    struct Score {
+        size_t tracksCount = 4;
+        size_t notesCount = 64;
+    };
+
+    //! Notes of every track start off the block boundaries and off each other, most of them
+    //! land in the middle of a block
+    static Events trackEvents(const Score& score, size_t trackIdx)
+    {
+        Events events;
+
+        for (size_t noteIdx = 0; noteIdx < score.notesCount; ++noteIdx) {
+            tick_t on = static_cast<tick_t>(noteIdx * DIVISION / 2 + trackIdx * 7);
+            tick_t off = on + DIVISION / 2 - 13;
+
+            Event noteOn(Event::Opcode::NoteOn);
+            noteOn.setChannel(static_cast<channel_t>(trackIdx % 16));
+            noteOn.setNote(static_cast<uint8_t>(48 + (noteIdx * 7 + trackIdx * 5) % 36));
+            noteOn.setVelocity(static_cast<uint16_t>(noteOn.maxVelocity() / 2 + noteIdx * 311 % (noteOn.maxVelocity() / 2)));
+
+            Event noteOff = noteOn;
+            noteOff.setOpcode(Event::Opcode::NoteOff);
+
+            events[on].push_back(noteOn);
+            events[off].push_back(noteOff);
+        }
+
+        return events;
+    }
+
+    static tick_t lastTick(const Score& score)
+    {
+        return static_cast<tick_t>(score.notesCount * DIVISION / 2 + DIVISION);
+    }
+
+    static samples_t samplesCount(const Score& score)
+    {
+        return static_cast<samples_t>(static_cast<uint64_t>(lastTick(score)) * TEMPO / DIVISION * SAMPLE_RATE / 1000000);
+    }
+
+    struct Env {
+        MixerPtr mixer;
+        std::vector<MidiData> midiData;
+        std::vector<std::shared_ptr<MidiAudioSource> > sources;
+
+        std::shared_ptr<NiceMock<synth::SynthResolverMock> > synthResolver;
+        std::shared_ptr<NiceMock<MidiOutPortMock> > midiOutPort;
+    };
+
+    //! Sets up the mixer with a MIDI track per score track, the whole score is sent to the sources
+    //! before the first block, as if it was rendered ahead of the playback
+    Env makeEnv(const Score& score, bool isEventSampleOffsetSupported)
+    {
+        Env env;
+
+        env.mixer = std::make_shared<Mixer>();
+        env.mixer->setAudioChannelsCount(CHANNELS_COUNT);
+        env.mixer->setSampleRate(SAMPLE_RATE);
+
+        env.synthResolver = std::make_shared<NiceMock<synth::SynthResolverMock> >();
+        env.midiOutPort = std::make_shared<NiceMock<MidiOutPortMock> >();
+
+        ON_CALL(*env.synthResolver, resolveSynth(_, _))
+        .WillByDefault([isEventSampleOffsetSupported](const TrackId, const AudioInputParams&) {
+            return std::make_shared<tests::TestSynthesizer>(isEventSampleOffsetSupported);
+        });
+
+        env.midiData.resize(score.tracksCount);
+
+        for (size_t trackIdx = 0; trackIdx < score.tracksCount; ++trackIdx) {
+            MidiData& midiData = env.midiData[trackIdx];
+            midiData.mapping.division = DIVISION;
+            midiData.mapping.tempo = { { 0, TEMPO } };
+            midiData.mapping.programms = { Program() };
+            midiData.stream.lastTick = lastTick(score);
+
+            TrackId trackId = static_cast<TrackId>(trackIdx);
+
+            auto source = std::make_shared<MidiAudioSource>(trackId, midiData);
+            source->setsynthResolver(env.synthResolver);
+            source->setmidiOutPort(env.midiOutPort);
+            source->applyInputParams(AudioInputParams());
+
+            //! NOTE Answers the request the source has sent on its creation, with all the events at once
+            midiData.stream.mainStream.send(trackEvents(score, trackIdx), midiData.stream.lastTick);
+
+            env.mixer->addChannel(trackId, source);
+            source->setIsActive(true);
+
+            env.sources.push_back(source);
+        }
+
+        return env;
+    }
+
+    //! Calls the sources right away, block after block, and sums them up as the mixer does before its dynamics stages.
+    //! The gains of the channels and the master are left out, at the default params they are exact anyway
+    static std::vector<float> renderSources(Env& env, samples_t samplesCount)
+    {
+        std::vector<float> output(samplesCount * CHANNELS_COUNT, 0.f);
+        std::vector<float> sourceBuffer(BLOCK_SIZE * CHANNELS_COUNT, 0.f);
+
+        for (samples_t from = 0; from < samplesCount; from += BLOCK_SIZE) {
+            samples_t blockSize = std::min(BLOCK_SIZE, samplesCount - from);
+            float* block = output.data() + from * CHANNELS_COUNT;
+
+            for (const std::shared_ptr<MidiAudioSource>& source : env.sources) {
+                samples_t processedSamplesCount = source->process(sourceBuffer.data(), blockSize);
+
+                for (size_t i = 0; i < processedSamplesCount * CHANNELS_COUNT; ++i) {
+                    block[i] += sourceBuffer[i];
+                }
+
+                std::fill(sourceBuffer.begin(), sourceBuffer.end(), 0.f);
+            }
+        }
+
+        return output;
+    }
+
+    //! Calls the mixer right away, block after block, as fast as it goes
+    static std::vector<float> render(Env& env, samples_t samplesCount)
+    {
+        std::vector<float> output(samplesCount * CHANNELS_COUNT, 0.f);
+
+        for (samples_t from = 0; from < samplesCount; from += BLOCK_SIZE) {
+            samples_t blockSize = std::min(BLOCK_SIZE, samplesCount - from);
+            env.mixer->process(output.data() + from * CHANNELS_COUNT, blockSize);
+        }
+
+        return output;
+    }
+
+    static uint64_t hash(const std::vector<float>& samples)
+    {
+        uint64_t hash = FNV_OFFSET_BASIS;
+
+        for (float sample : samples) {
+            uint32_t bits = 0;
+            std::memcpy(&bits, &sample, sizeof(bits));
+
+            for (size_t byte = 0; byte < sizeof(bits); ++byte) {
+                hash ^= (bits >> (byte * 8)) & 0xff;
+                hash *= FNV_PRIME;
+            }
+        }
+
+        return hash;
+    }
+
+    static bool isSilent(const std::vector<float>& samples)
+    {
+        return std::all_of(samples.cbegin(), samples.cend(), [](float sample) { return sample == 0.f; });
+    }
+};
+
+/**
+ * @brief MixerRenderTests_goldenHash
+ * @details Renders a score through the MIDI sources with a synth whose output is bit exact and mixes them,
+ *          the result must match the recorded one, on every platform and build
+ */
+TEST_F(MixerRenderTests, goldenHash)
+{
+    Score score;
+    Env env = makeEnv(score, true);
+
+    std::vector<float> output = renderSources(env, samplesCount(score));
+
+    ASSERT_FALSE(isSilent(output));
+    EXPECT_EQ(hash(output), GOLDEN_HASH);
+}
+
+/**
+ * @brief MixerRenderTests_splitBlocksMatchSampleOffsets
+ * @details A synth without the support of the sample offsets gets the block rendered in parts, split at the events,
+ *          the events must take effect at exactly the same samples
+ */
+TEST_F(MixerRenderTests, splitBlocksMatchSampleOffsets)
+{
+    Score score;
+    Env offsetsEnv = makeEnv(score, true);
+    Env splitEnv = makeEnv(score, false);
+
+    std::vector<float> expected = render(offsetsEnv, samplesCount(score));
+    std::vector<float> output = render(splitEnv, samplesCount(score));
+
+    ASSERT_EQ(output.size(), expected.size());
+    for (size_t i = 0; i < output.size(); ++i) {
+        ASSERT_EQ(output[i], expected[i]) << "frame " << i / CHANNELS_COUNT;
+    }
+}
+
+/**
+ * @brief MixerRenderTests_renderIsRepeatable
+ * @details Rendering the same score again must give the same samples
+ */
+TEST_F(MixerRenderTests, renderIsRepeatable)
+{
+    Score score;
+    Env firstEnv = makeEnv(score, true);
+    Env secondEnv = makeEnv(score, true);
+
+    EXPECT_EQ(render(firstEnv, samplesCount(score)), render(secondEnv, samplesCount(score)));
+}
+
+/**
+ * @brief MixerRenderTests_renderBenchmark
+ * @details Renders a big score without any pacing, to measure the cost of the MIDI sources and the mixer.
+ *          Only reports the speed, it depends too much on the machine to be asserted.
+ *          Only runs if MIXER_RENDER_TIMING is set
+ */
+TEST_F(MixerRenderTests, renderBenchmark)
+{
+    if (!std::getenv("MIXER_RENDER_TIMING")) {
+        GTEST_SKIP() << "set MIXER_RENDER_TIMING to run";
+    }
+
+    Score score;
+    score.tracksCount = 32;
+    score.notesCount = 256;
+
+    Env env = makeEnv(score, true);
+    samples_t samples = samplesCount(score);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<float> output = render(env, samples);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double audioSeconds = static_cast<double>(samples) / SAMPLE_RATE;
+
+    LOGI() << score.tracksCount << " tracks, " << audioSeconds << " s of audio in " << seconds * 1000.0 << " ms, "
+           << audioSeconds / seconds << "x realtime";
+
+    EXPECT_FALSE(isSilent(output));
+}
@@ -0,0 +1,45 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_SYNTHRESOLVERMOCK_H
+#define MU_AUDIO_SYNTHRESOLVERMOCK_H
+
+#include <gmock/gmock.h>
+
+#include "framework/audio/isynthresolver.h"
+
+namespace mu::audio::synth {
+class SynthResolverMock : public ISynthResolver
+{
+public:
+    MOCK_METHOD(void, init, (const AudioInputParams&), (override));
+
+    MOCK_METHOD(ISynthesizerPtr, resolveSynth, (const TrackId, const AudioInputParams&), (const, override));
+    MOCK_METHOD(ISynthesizerPtr, resolveDefaultSynth, (const TrackId), (const, override));
+    MOCK_METHOD(AudioInputParams, resolveDefaultInputParams, (), (const, override));
+    MOCK_METHOD(AudioResourceMetaList, resolveAvailableResources, (), (const, override));
+    MOCK_METHOD(void, registerResolver, (const AudioSourceType, IResolverPtr), (override));
+
+    MOCK_METHOD(SynthesizerLoadChanges, synthesizersLoadChanges, (), (const, override));
+};
+}
+
+#endif // MU_AUDIO_SYNTHRESOLVERMOCK_H
@@ -0,0 +1,276 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "internal/dsp/polyphaseresampler.h"
+#include "internal/worker/samplerateconvertor.h"
+
+#include "log.h"
+
+using namespace mu::audio;
+
+static constexpr unsigned int CHANNELS_COUNT = 2;
+
+class ResamplerTests : public ::testing::Test
+{
+public:
+    static std::vector<float> sine(double frequency, unsigned int sampleRate, size_t frames, float amplitude = 0.5f)
+    {
+        std::vector<float> data(frames * CHANNELS_COUNT);
+
+        for (size_t frame = 0; frame < frames; ++frame) {
+            float value = amplitude * static_cast<float>(std::sin(2.0 * M_PI * frequency * frame / sampleRate));
+            for (unsigned int channel = 0; channel < CHANNELS_COUNT; ++channel) {
+                data[frame * CHANNELS_COUNT + channel] = value;
+            }
+        }
+
+        return data;
+    }
+
+    struct SineFit {
+        double amplitude = 0.0;
+        double residualRms = 0.0;
+    };
+
+    //! Least squares fit of a sine of the known frequency to the first channel of the frames [from, to),
+    //! whatever doesn't fit is the noise and the distortion
+    static SineFit fitSine(const std::vector<float>& data, double frequency, unsigned int sampleRate, size_t from, size_t to)
+    {
+        double ss = 0.0, sc = 0.0, cc = 0.0, ys = 0.0, yc = 0.0;
+
+        for (size_t frame = from; frame < to; ++frame) {
+            double phase = 2.0 * M_PI * frequency * frame / sampleRate;
+            double s = std::sin(phase);
+            double c = std::cos(phase);
+            double y = data[frame * CHANNELS_COUNT];
+
+            ss += s * s;
+            sc += s * c;
+            cc += c * c;
+            ys += y * s;
+            yc += y * c;
+        }
+
+        double det = ss * cc - sc * sc;
+        double a = (ys * cc - yc * sc) / det;
+        double b = (yc * ss - ys * sc) / det;
+
+        double residual = 0.0;
+        for (size_t frame = from; frame < to; ++frame) {
+            double phase = 2.0 * M_PI * frequency * frame / sampleRate;
+            double error = data[frame * CHANNELS_COUNT] - (a * std::sin(phase) + b * std::cos(phase));
+            residual += error * error;
+        }
+
+        SineFit fit;
+        fit.amplitude = std::sqrt(a * a + b * b);
+        fit.residualRms = std::sqrt(residual / (to - from));
+
+        return fit;
+    }
+
+    static double toDb(double ratio)
+    {
+        return 20.0 * std::log10(ratio);
+    }
+
+    struct RatesPair {
+        unsigned int in = 0;
+        unsigned int out = 0;
+    };
+
+    static std::vector<RatesPair> ratesPairs()
+    {
+        return {
+            { 44100, 48000 },
+            { 48000, 44100 },
+            { 22050, 44100 },
+            { 96000, 44100 },
+            { 44100, 44100 * 1009 / 1000 }, // a huge interpolation factor, the filter bank is interpolated
+        };
+    }
+};
+
+/**
+ * @brief ResamplerTests_sineThdN
+ * @details Converts a 1 kHz sine between the common rates and checks the THD+N of the result,
+ *          the edges, where the filter still sees the silence around the signal, are left out
+ */
+TEST_F(ResamplerTests, sineThdN)
+{
+    constexpr double FREQUENCY = 1000.0;
+    constexpr double MAX_THD_N_DB = -80.0;
+
+    for (const RatesPair& rates : ratesPairs()) {
+        std::vector<float> input = sine(FREQUENCY, rates.in, rates.in);
+        SampleRateConvertor convertor(input, CHANNELS_COUNT, rates.in, rates.out);
+        std::vector<float> output = convertor.convert();
+
+        size_t outputFrames = output.size() / CHANNELS_COUNT;
+        ASSERT_EQ(outputFrames, static_cast<size_t>(rates.out)) << rates.in << " -> " << rates.out;
+
+        size_t margin = rates.out / 10;
+        SineFit fit = fitSine(output, FREQUENCY, rates.out, margin, outputFrames - margin);
+
+        EXPECT_NEAR(fit.amplitude, 0.5, 0.5 * 0.001) << rates.in << " -> " << rates.out;
+        EXPECT_LT(toDb(fit.residualRms / (fit.amplitude / std::sqrt(2.0))), MAX_THD_N_DB) << rates.in << " -> " << rates.out;
+    }
+}
+
+/**
+ * @brief ResamplerTests_passbandRipple
+ * @details Measures the gain of sines across the passband, the level must stay flat
+ */
+TEST_F(ResamplerTests, passbandRipple)
+{
+    constexpr double MAX_RIPPLE_DB = 0.01;
+
+    for (const RatesPair& rates : ratesPairs()) {
+        double passbandEdge = 0.8 * std::min(rates.in, rates.out) / 2.0;
+        double minGain = 1.0;
+        double maxGain = 1.0;
+
+        for (double frequency = 50.0; frequency < passbandEdge; frequency *= 1.5) {
+            std::vector<float> input = sine(frequency, rates.in, rates.in / 4);
+            SampleRateConvertor convertor(input, CHANNELS_COUNT, rates.in, rates.out);
+            std::vector<float> output = convertor.convert();
+
+            size_t outputFrames = output.size() / CHANNELS_COUNT;
+            size_t margin = outputFrames / 8;
+            double gain = fitSine(output, frequency, rates.out, margin, outputFrames - margin).amplitude / 0.5;
+
+            minGain = std::min(minGain, gain);
+            maxGain = std::max(maxGain, gain);
+        }
+
+        EXPECT_LT(toDb(maxGain) - toDb(minGain), MAX_RIPPLE_DB) << rates.in << " -> " << rates.out;
+    }
+}
+
+/**
+ * @brief ResamplerTests_downsamplingAliasing
+ * @details A sine above the output Nyquist frequency must be filtered out, instead of folding back into the band
+ */
+TEST_F(ResamplerTests, downsamplingAliasing)
+{
+    constexpr unsigned int RATE_IN = 96000;
+    constexpr unsigned int RATE_OUT = 44100;
+    constexpr double MIN_ATTENUATION_DB = 80.0;
+
+    std::vector<float> input = sine(30000.0, RATE_IN, RATE_IN);
+    SampleRateConvertor convertor(input, CHANNELS_COUNT, RATE_IN, RATE_OUT);
+    std::vector<float> output = convertor.convert();
+
+    size_t outputFrames = output.size() / CHANNELS_COUNT;
+    double energy = 0.0;
+    for (size_t frame = RATE_OUT / 10; frame < outputFrames - RATE_OUT / 10; ++frame) {
+        energy += output[frame * CHANNELS_COUNT] * output[frame * CHANNELS_COUNT];
+    }
+
+    double rms = std::sqrt(energy / (outputFrames - RATE_OUT / 5));
+    EXPECT_GT(toDb(0.5 / std::sqrt(2.0)) - toDb(rms), MIN_ATTENUATION_DB);
+}
+
+/**
+ * @brief ResamplerTests_streamingMatchesOneShot
+ * @details Converting block by block, from the start or after a seek, must give the same samples
+ *          as the conversion at once, the tail of the stream included
+ */
+TEST_F(ResamplerTests, streamingMatchesOneShot)
+{
+    constexpr unsigned int BLOCK_SIZE = 512;
+
+    for (const RatesPair& rates : ratesPairs()) {
+        std::vector<float> input = sine(440.0, rates.in, rates.in / 2 + 123);
+        std::vector<float> expected = SampleRateConvertor(input, CHANNELS_COUNT, rates.in, rates.out).convert();
+        size_t expectedFrames = expected.size() / CHANNELS_COUNT;
+
+        for (size_t start : { size_t(0), expectedFrames / 3 }) {
+            SampleRateConvertor convertor(input, CHANNELS_COUNT, rates.in, rates.out);
+            std::vector<float> block(BLOCK_SIZE * CHANNELS_COUNT);
+            size_t from = start;
+
+            while (true) {
+                unsigned int converted = convertor.convert(block.data(), static_cast<unsigned int>(from), BLOCK_SIZE);
+                if (converted == 0) {
+                    break;
+                }
+
+                for (size_t i = 0; i < converted * CHANNELS_COUNT; ++i) {
+                    ASSERT_FLOAT_EQ(block[i], expected[from * CHANNELS_COUNT + i])
+                        << rates.in << " -> " << rates.out << ", frame " << from + i / CHANNELS_COUNT;
+                }
+
+                from += converted;
+            }
+
+            EXPECT_EQ(from, expectedFrames) << rates.in << " -> " << rates.out << ", from " << start;
+        }
+    }
+}
+
+/**
+ * @brief ResamplerTests_throughputBenchmark
+ * @details Measures the conversion of a stereo stream, in blocks as the audio thread does it.
+ *          Only reports the speed, it depends too much on the machine to be asserted.
+ *          Only runs if RESAMPLER_TIMING is set
+ */
+TEST_F(ResamplerTests, throughputBenchmark)
+{
+    if (!std::getenv("RESAMPLER_TIMING")) {
+        GTEST_SKIP() << "set RESAMPLER_TIMING to run";
+    }
+
+    constexpr unsigned int BLOCK_SIZE = 512;
+    constexpr unsigned int SECONDS = 10;
+
+    for (const RatesPair& rates : ratesPairs()) {
+        std::vector<float> input = sine(1000.0, rates.in, rates.in * SECONDS);
+        dsp::PolyphaseResampler resampler(CHANNELS_COUNT, rates.in, rates.out);
+        std::vector<float> block(BLOCK_SIZE * CHANNELS_COUNT);
+
+        size_t inputFrames = input.size() / CHANNELS_COUNT;
+        size_t inputFrame = resampler.reset(0);
+        size_t outputFrames = 0;
+
+        auto start = std::chrono::steady_clock::now();
+
+        while (inputFrame < inputFrames) {
+            size_t inputFramesUsed = 0;
+            outputFrames += resampler.process(input.data() + inputFrame * CHANNELS_COUNT, inputFrames - inputFrame, inputFramesUsed,
+                                              block.data(), BLOCK_SIZE);
+            inputFrame += inputFramesUsed;
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        LOGI() << rates.in << " -> " << rates.out << ": " << outputFrames / seconds / 1e6 << " M frames/s, "
+               << SECONDS / seconds << "x realtime, " << resampler.tapsCount() << " taps";
+    }
+}
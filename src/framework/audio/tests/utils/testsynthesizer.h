@@ -0,0 +1,192 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_AUDIO_TESTSYNTHESIZER_H
+#define MU_AUDIO_TESTSYNTHESIZER_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "framework/audio/isynthesizer.h"
+
+namespace mu::audio::tests {
+//! NOTE A sawtooth synth whose output is bit exact on every platform: the phases are integers
+//! and every product is exact in float, so neither the math library nor fused multiply-adds change a bit.
+//! Events either take effect at a sample offset into the next block or, like Fluid, at the start of it
+class TestSynthesizer : public synth::ISynthesizer
+{
+public:
+    explicit TestSynthesizer(bool isEventSampleOffsetSupported)
+        : m_isEventSampleOffsetSupported(isEventSampleOffsetSupported)
+    {
+    }
+
+    bool isValid() const override { return true; }
+
+    std::string name() const override { return "Test"; }
+    AudioSourceType type() const override { return AudioSourceType::Undefined; }
+    const AudioInputParams& params() const override { return m_params; }
+    async::Channel<AudioInputParams> paramsChanged() const override { return m_paramsChanged; }
+    synth::SoundFontFormats soundFontFormats() const override { return {}; }
+
+    Ret init() override { return make_ret(Ret::Code::Ok); }
+    Ret addSoundFonts(const std::vector<io::path>&) override { return make_ret(Ret::Code::Ok); }
+    Ret removeSoundFonts() override { return make_ret(Ret::Code::Ok); }
+
+    Ret setupMidiChannels(const std::vector<midi::Event>&) override { return make_ret(Ret::Code::Ok); }
+
+    bool handleEvent(const midi::Event& e) override
+    {
+        return handleEvent(e, 0);
+    }
+
+    bool isEventSampleOffsetSupported() const override
+    {
+        return m_isEventSampleOffsetSupported;
+    }
+
+    bool handleEvent(const midi::Event& e, samples_t sampleOffset) override
+    {
+        m_pendingEvents.push_back({ m_isEventSampleOffsetSupported ? sampleOffset : 0, e });
+        return true;
+    }
+
+    void allSoundsOff() override { m_voices.clear(); }
+    void flushSound() override { m_voices.clear(); }
+    void midiChannelSoundsOff(midi::channel_t) override {}
+    bool midiChannelVolume(midi::channel_t, float) override { return true; }
+    bool midiChannelBalance(midi::channel_t, float) override { return true; }
+    bool midiChannelPitch(midi::channel_t, int16_t) override { return true; }
+
+    async::Channel<SynthesizerLoad> loadChanged() const override { return m_loadChanged; }
+
+    // IAudioSource
+    bool isActive() const override { return m_isActive; }
+    void setIsActive(bool arg) override { m_isActive = arg; }
+
+    void setSampleRate(unsigned int sampleRate) override { m_sampleRate = sampleRate; }
+    unsigned int audioChannelsCount() const override { return 2; }
+    async::Channel<unsigned int> audioChannelsCountChanged() const override { return m_audioChannelsCountChanged; }
+
+    samples_t process(float* buffer, samples_t samplesPerChannel) override
+    {
+        std::stable_sort(m_pendingEvents.begin(), m_pendingEvents.end(), [](const PendingEvent& l, const PendingEvent& r) {
+            return l.offset < r.offset;
+        });
+
+        size_t eventIdx = 0;
+
+        for (samples_t s = 0; s < samplesPerChannel; ++s) {
+            while (eventIdx < m_pendingEvents.size() && m_pendingEvents[eventIdx].offset <= s) {
+                applyEvent(m_pendingEvents[eventIdx].event);
+                ++eventIdx;
+            }
+
+            float value = 0.f;
+            for (Voice& voice : m_voices) {
+                //! NOTE 16 bits of the phase times a 7 bits velocity and a power of two gain, the product is exact
+                float saw = static_cast<float>(static_cast<int32_t>(voice.phase) >> 16) / 32768.f;
+                value += saw * voice.gain;
+                voice.phase += voice.increment;
+            }
+
+            buffer[s * 2] = value;
+            buffer[s * 2 + 1] = value;
+        }
+
+        for (; eventIdx < m_pendingEvents.size(); ++eventIdx) {
+            applyEvent(m_pendingEvents[eventIdx].event);
+        }
+
+        m_pendingEvents.clear();
+
+        return samplesPerChannel;
+    }
+
+private:
+    struct Voice {
+        midi::channel_t channel = 0;
+        uint8_t note = 0;
+        uint32_t phase = 0;
+        uint32_t increment = 0;
+        float gain = 0.f;
+    };
+
+    struct PendingEvent {
+        samples_t offset = 0;
+        midi::Event event;
+    };
+
+    void applyEvent(const midi::Event& e)
+    {
+        if (e.opcode() != midi::Event::Opcode::NoteOn && e.opcode() != midi::Event::Opcode::NoteOff) {
+            return;
+        }
+
+        m_voices.erase(std::remove_if(m_voices.begin(), m_voices.end(), [&e](const Voice& voice) {
+            return voice.channel == e.channel() && voice.note == e.note();
+        }), m_voices.end());
+
+        uint16_t velocity = e.velocity() * 127 / e.maxVelocity();
+        if (e.opcode() == midi::Event::Opcode::NoteOff || velocity == 0 || m_sampleRate == 0) {
+            return;
+        }
+
+        Voice voice;
+        voice.channel = e.channel();
+        voice.note = e.note();
+        voice.increment = phaseIncrement(e.note());
+        voice.gain = static_cast<float>(velocity) / 128.f / 32.f;
+
+        m_voices.push_back(voice);
+    }
+
+    uint32_t phaseIncrement(uint8_t note) const
+    {
+        //! NOTE The equal temperament frequencies of the octave from the middle C, in millihertz
+        static constexpr std::array<uint64_t, 12> MIDDLE_OCTAVE_MILLIHERTZ {
+            261626, 277183, 293665, 311127, 329628, 349228, 369994, 391995, 415305, 440000, 466164, 493883
+        };
+
+        uint64_t millihertz = MIDDLE_OCTAVE_MILLIHERTZ[note % 12];
+        int octave = note / 12 - 5;
+        millihertz = octave >= 0 ? millihertz << octave : millihertz >> -octave;
+
+        return static_cast<uint32_t>((millihertz << 32) / (static_cast<uint64_t>(m_sampleRate) * 1000));
+    }
+
+    bool m_isEventSampleOffsetSupported = false;
+    bool m_isActive = false;
+    unsigned int m_sampleRate = 0;
+
+    std::vector<Voice> m_voices;
+    std::vector<PendingEvent> m_pendingEvents;
+
+    AudioInputParams m_params;
+    async::Channel<AudioInputParams> m_paramsChanged;
+    async::Channel<unsigned int> m_audioChannelsCountChanged;
+    async::Channel<SynthesizerLoad> m_loadChanged;
+};
+}
+
+#endif // MU_AUDIO_TESTSYNTHESIZER_H
@@ -25,6 +25,7 @@
 
 #include <string>
 #include <sstream>
+#include <memory>
 #include <cstdint>
 #include <vector>
 #include <map>
@@ -32,6 +33,7 @@
 #include <set>
 #include <cassert>
 #include "async/channel.h"
+#include "async/notification.h"
 #include "retval.h"
 #include "midievent.h"
 
@@ -76,6 +78,21 @@ struct MidiMapping {
     }
 };
 
+//! NOTE Events rendered ahead of the playback, they are never changed after sending,
+//! so they are shared with the audio thread without copying.
+//! The sender holds them until the audio thread doesn't anymore, so that they are never deleted there
+struct PrefetchedEvents {
+    tick_t from = 0;
+    tick_t to = 0;
+    Events events;
+
+    bool containsTick(const tick_t tick) const
+    {
+        return tick >= from && tick < to;
+    }
+};
+using PrefetchedEventsPtr = std::shared_ptr<const PrefetchedEvents>;
+
 struct MidiStream {
     tick_t lastTick = 0;
 
@@ -84,6 +101,10 @@ struct MidiStream {
     async::Channel<Events, tick_t /*endTick*/> backgroundStream;
     async::Channel<tick_t /*from*/, tick_t /*from*/> eventsRequest;
 
+    //! NOTE nullptr means that all the prefetched events are outdated
+    async::Channel<PrefetchedEventsPtr> prefetchStream;
+    async::Notification prefetchReleased;
+
     bool operator==(const MidiStream& other) const
     {
         return lastTick == other.lastTick
@@ -0,0 +1,86 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_TESTING_QTESTFILESTIMING_H
+#define MU_TESTING_QTESTFILESTIMING_H
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QtTest/QtTest>
+
+namespace mu::testing {
+//! NOTE Times operations over a list of files and reports the time spent per file and in total.
+//! It only runs if the given environment variable sets the number of rounds per file,
+//! e.g. MXML_IMPORT_TIMING=10 for ten rounds
+class QTestFilesTiming
+{
+public:
+    using Operation = std::function<bool (const QString& file)>;
+    using Operations = std::vector<std::pair<QString /*name*/, Operation> >;
+
+    explicit QTestFilesTiming(const char* envVariable)
+        : m_rounds(qEnvironmentVariableIntValue(envVariable)) {}
+
+    bool isEnabled() const
+    {
+        return m_rounds > 0;
+    }
+
+    void run(const QStringList& files, const Operations& operations) const
+    {
+        std::vector<qint64> totalMsecs(operations.size(), 0);
+
+        for (const QString& file : files) {
+            QString report = file + ":";
+
+            for (size_t opIdx = 0; opIdx < operations.size(); ++opIdx) {
+                QElapsedTimer timer;
+                timer.start();
+                for (int i = 0; i < m_rounds; ++i) {
+                    QVERIFY2(operations[opIdx].second(file), qPrintable(operations[opIdx].first + " failed: " + file));
+                }
+                const qint64 elapsedMsecs = timer.elapsed();
+
+                totalMsecs[opIdx] += elapsedMsecs;
+                report += QString(" %1 %2 ms").arg(operations[opIdx].first).arg(double(elapsedMsecs) / m_rounds, 0, 'f', 2);
+            }
+
+            qDebug("%s per round", qPrintable(report));
+        }
+
+        QString report = QString("%1 files, total").arg(files.size());
+        for (size_t opIdx = 0; opIdx < operations.size(); ++opIdx) {
+            report += QString(" %1 %2 ms").arg(operations[opIdx].first).arg(totalMsecs[opIdx]);
+        }
+
+        qDebug("%s for %d rounds", qPrintable(report), m_rounds);
+    }
+
+private:
+    int m_rounds = 0;
+};
+}
+
+#endif // MU_TESTING_QTESTFILESTIMING_H
@@ -21,6 +21,8 @@
  */
 #include "vstsynthesiser.h"
 
+#include <cmath>
+
 #include "log.h"
 
 #include "internal/vstplugin.h"
@@ -28,6 +30,8 @@
 using namespace mu;
 using namespace mu::vst;
 
+static const audio::samples_t RENDER_LOAD_WINDOW_SAMPLES { 2048 };
+
 VstSynthesiser::VstSynthesiser(VstPluginPtr&& pluginPtr, const audio::AudioInputParams& params)
     : m_pluginPtr(pluginPtr), m_vstAudioClient(std::make_unique<VstAudioClient>()), m_params(params)
 {
@@ -119,12 +123,22 @@ Ret VstSynthesiser::removeSoundFonts()
 }
 
 bool VstSynthesiser::handleEvent(const midi::Event& e)
+{
+    return handleEvent(e, 0);
+}
+
+bool VstSynthesiser::isEventSampleOffsetSupported() const
+{
+    return true;
+}
+
+bool VstSynthesiser::handleEvent(const midi::Event& e, audio::samples_t sampleOffset)
 {
     if (!m_vstAudioClient) {
         return false;
     }
 
-    return m_vstAudioClient->handleEvent(e);
+    return m_vstAudioClient->handleEvent(e, sampleOffset);
 }
 
 void VstSynthesiser::allSoundsOff()
@@ -166,8 +180,14 @@ bool VstSynthesiser::midiChannelPitch(midi::channel_t /*chan*/, int16_t /*val*/)
     return true;
 }
 
+async::Channel<audio::SynthesizerLoad> VstSynthesiser::loadChanged() const
+{
+    return m_loadChanged;
+}
+
 void VstSynthesiser::setSampleRate(unsigned int sampleRate)
 {
+    m_sampleRate = sampleRate;
     m_vstAudioClient->setSampleRate(sampleRate);
 }
 
@@ -189,5 +209,39 @@ audio::samples_t VstSynthesiser::process(float* buffer, audio::samples_t samplel
 
     m_vstAudioClient->setBlockSize(samplelPerChannel);
 
-    return m_vstAudioClient->process(buffer, samplelPerChannel);
+    auto startTime = std::chrono::steady_clock::now();
+
+    audio::samples_t result = m_vstAudioClient->process(buffer, samplelPerChannel);
+
+    updateRenderLoad(std::chrono::steady_clock::now() - startTime, samplelPerChannel);
+
+    return result;
+}
+
+void VstSynthesiser::updateRenderLoad(std::chrono::steady_clock::duration renderTime, audio::samples_t samplesPerChannel)
+{
+    m_renderTime += renderTime;
+    m_renderedSamples += samplesPerChannel;
+
+    if (m_renderedSamples < RENDER_LOAD_WINDOW_SAMPLES || m_sampleRate == 0) {
+        return;
+    }
+
+    double windowSecs = static_cast<double>(m_renderedSamples) / m_sampleRate;
+    double load = std::chrono::duration<double>(m_renderTime).count() / windowSecs;
+
+    m_renderTime = std::chrono::steady_clock::duration::zero();
+    m_renderedSamples = 0;
+
+    //! NOTE The plugin manages its voices itself, only the time it takes is known
+    audio::SynthesizerLoad currentLoad = m_load;
+    currentLoad.renderLoad = std::round(static_cast<float>(load) * 100.f) / 100.f;
+    if (load > 1.0) {
+        currentLoad.overruns++;
+    }
+
+    if (currentLoad != m_load) {
+        m_load = currentLoad;
+        m_loadChanged.send(m_load);
+    }
 }
@@ -23,6 +23,7 @@
 #ifndef MU_VST_VSTSYNTHESISER_H
 #define MU_VST_VSTSYNTHESISER_H
 
+#include <chrono>
 #include <memory>
 
 #include "async/asyncable.h"
@@ -63,6 +64,8 @@ public:
     Ret removeSoundFonts() override;
 
     bool handleEvent(const midi::Event& e) override;
+    bool isEventSampleOffsetSupported() const override;
+    bool handleEvent(const midi::Event& e, audio::samples_t sampleOffset) override;
     void allSoundsOff() override;
     void flushSound() override;
 
@@ -72,6 +75,8 @@ public:
     bool midiChannelBalance(midi::channel_t chan, float val) override;
     bool midiChannelPitch(midi::channel_t chan, int16_t val) override;
 
+    async::Channel<audio::SynthesizerLoad> loadChanged() const override;
+
     // IAudioSource
     void setSampleRate(unsigned int sampleRate) override;
     unsigned int audioChannelsCount() const override;
@@ -79,6 +84,8 @@ public:
     audio::samples_t process(float* buffer, audio::samples_t samplelPerChannel) override;
 
 private:
+    void updateRenderLoad(std::chrono::steady_clock::duration renderTime, audio::samples_t samplesPerChannel);
+
     VstPluginPtr m_pluginPtr = nullptr;
 
     std::unique_ptr<VstAudioClient> m_vstAudioClient = nullptr;
@@ -89,6 +96,14 @@ private:
 
     async::Channel<audio::AudioInputParams> m_paramsChanges;
     async::Channel<unsigned int> m_streamsCountChanged;
+
+    //! NOTE The render time is measured over a window of samples, a single block is too short to be meaningful
+    std::chrono::steady_clock::duration m_renderTime = std::chrono::steady_clock::duration::zero();
+    audio::samples_t m_renderedSamples = 0;
+    unsigned int m_sampleRate = 0;
+
+    audio::SynthesizerLoad m_load;
+    async::Channel<audio::SynthesizerLoad> m_loadChanged;
 };
 
 using VstSynthPtr = std::shared_ptr<VstSynthesiser>;
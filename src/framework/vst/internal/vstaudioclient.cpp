@@ -53,7 +53,7 @@ void VstAudioClient::init(VstPluginType&& type, VstPluginPtr plugin, audio::audi
     m_audioChannelsCount = audioChannelsCount;
 }
 
-bool VstAudioClient::handleEvent(const mu::midi::Event& e)
+bool VstAudioClient::handleEvent(const mu::midi::Event& e, audio::samples_t sampleOffset)
 {
     VstEvent ev;
 
@@ -61,6 +61,9 @@ bool VstAudioClient::handleEvent(const mu::midi::Event& e)
         return false;
     }
 
+    //! NOTE The plugin applies the event at this sample of the next processed block
+    ev.sampleOffset = static_cast<Steinberg::int32>(sampleOffset);
+
     if (m_eventList.addEvent(ev) == Steinberg::kResultTrue) {
         return true;
     }
@@ -36,7 +36,7 @@ public:
 
     void init(VstPluginType&& type, VstPluginPtr plugin, audio::audioch_t&& audioChannelsCount = 2);
 
-    bool handleEvent(const midi::Event& e);
+    bool handleEvent(const midi::Event& e, audio::samples_t sampleOffset = 0);
 
     audio::samples_t process(float* output, audio::samples_t samplesPerChannel);
     void flush();
@@ -23,6 +23,7 @@
 #include <set>
 
 #include <QMessageBox>
+#include <QtConcurrent>
 
 #include "engraving/compat/midi/midifile.h"
 #include "engraving/style/style.h"
@@ -188,7 +189,7 @@ void setChordVoice(MidiChord& chord, int voice)
 
 void findAllTupletsForDrums(
     MTrack& mtrack,
-    TimeSigMap* sigmap,
+    const TimeSigMap* sigmap,
     const ReducedFraction& basicQuant)
 {
     const size_t drumVoiceCount = 2;
@@ -227,58 +228,79 @@ void findAllTupletsForDrums(
     // note: temporary local tuplets and chords are deleted here
 }
 
+//---------------------------------------------------------
+//   quantizeTrack
+//    the track only reads shared data: the import operations
+//    and the time signature map, so tracks can be quantized concurrently
+//---------------------------------------------------------
+
+static void quantizeTrack(MTrack& mtrack,
+                          const TimeSigMap* sigmap,
+                          const ReducedFraction& lastTick)
+{
+    // pass current track index through MidiImportOperations
+    // for further usage; the current track is per thread
+    MidiOperations::CurrentTrackSetter setCurrentTrack{ midiImportOperations, mtrack.indexOfOperation };
+
+    const auto& opers = midiImportOperations.data()->trackOpers;
+    const auto basicQuant = Quantize::quantValueToFraction(
+        opers.quantValue.value(mtrack.indexOfOperation));
+#ifdef QT_DEBUG
+    Q_ASSERT_X(MChord::isLastTickValid(lastTick, mtrack.chords),
+               "quantizeTrack", "Last tick is less than max note off time");
+#endif
+    MChord::setBarIndexes(mtrack.chords, basicQuant, lastTick, sigmap);
+
+    if (mtrack.mtrack->drumTrack()) {
+        findAllTupletsForDrums(mtrack, sigmap, basicQuant);
+    } else {
+        MidiTuplet::findAllTuplets(mtrack.tuplets, mtrack.chords, sigmap, basicQuant);
+    }
+#ifdef QT_DEBUG
+    Q_ASSERT_X(!doNotesOverlap(mtrack),
+               "quantizeTrack",
+               "There are overlapping notes of the same voice that is incorrect");
+#endif
+    // (4/3 of the smallest duration) tol is less sensitive
+    // to on time inaccuracies than 1/2 earlier
+    MChord::collectChords(mtrack, { 2, 1 }, { 4, 3 });
+    Quantize::quantizeChords(mtrack.chords, sigmap, basicQuant);
+    MidiTuplet::removeEmptyTuplets(mtrack);
+#ifdef QT_DEBUG
+    Q_ASSERT_X(MidiTuplet::areTupletRangesOk(mtrack.chords, mtrack.tuplets),
+               "quantizeTrack", "Tuplet chord/note is outside tuplet "
+                                "or non-tuplet chord/note is inside tuplet");
+#endif
+}
+
 void quantizeAllTracks(std::multimap<int, MTrack>& tracks,
                        TimeSigMap* sigmap,
                        const ReducedFraction& lastTick)
 {
     auto& opers = midiImportOperations;
 
+    // operations are only modified here, before the tracks are processed
+    std::vector<MTrack*> tracksToQuantize;
     for (auto& track: tracks) {
         MTrack& mtrack = track.second;
         if (mtrack.chords.empty()) {
             continue;
         }
-        // pass current track index through MidiImportOperations
-        // for further usage
-        MidiOperations::CurrentTrackSetter setCurrentTrack{ opers, mtrack.indexOfOperation };
-
         if (opers.data()->processingsOfOpenedFile == 0) {
             opers.data()->trackOpers.isDrumTrack.setValue(
-                opers.currentTrack(), mtrack.mtrack->drumTrack());
+                mtrack.indexOfOperation, mtrack.mtrack->drumTrack());
             if (mtrack.mtrack->drumTrack()) {
                 opers.data()->trackOpers.maxVoiceCount.setValue(
-                    opers.currentTrack(), MidiOperations::VoiceCount::V_1);
+                    mtrack.indexOfOperation, MidiOperations::VoiceCount::V_1);
             }
         }
-        const auto basicQuant = Quantize::quantValueToFraction(
-            opers.data()->trackOpers.quantValue.value(mtrack.indexOfOperation));
-#ifdef QT_DEBUG
-        Q_ASSERT_X(MChord::isLastTickValid(lastTick, mtrack.chords),
-                   "quantizeAllTracks", "Last tick is less than max note off time");
-#endif
-        MChord::setBarIndexes(mtrack.chords, basicQuant, lastTick, sigmap);
-
-        if (mtrack.mtrack->drumTrack()) {
-            findAllTupletsForDrums(mtrack, sigmap, basicQuant);
-        } else {
-            MidiTuplet::findAllTuplets(mtrack.tuplets, mtrack.chords, sigmap, basicQuant);
-        }
-#ifdef QT_DEBUG
-        Q_ASSERT_X(!doNotesOverlap(track.second),
-                   "quantizeAllTracks",
-                   "There are overlapping notes of the same voice that is incorrect");
-#endif
-        // (4/3 of the smallest duration) tol is less sensitive
-        // to on time inaccuracies than 1/2 earlier
-        MChord::collectChords(mtrack, { 2, 1 }, { 4, 3 });
-        Quantize::quantizeChords(mtrack.chords, sigmap, basicQuant);
-        MidiTuplet::removeEmptyTuplets(mtrack);
-#ifdef QT_DEBUG
-        Q_ASSERT_X(MidiTuplet::areTupletRangesOk(mtrack.chords, mtrack.tuplets),
-                   "quantizeAllTracks", "Tuplet chord/note is outside tuplet "
-                                        "or non-tuplet chord/note is inside tuplet");
-#endif
+        tracksToQuantize.push_back(&mtrack);
     }
+
+    // every track is independent of the others, so the result is the same as for the serial run
+    QtConcurrent::blockingMap(tracksToQuantize, [sigmap, &lastTick](MTrack* mtrack) {
+        quantizeTrack(*mtrack, sigmap, lastTick);
+    });
 }
 
 //---------------------------------------------------------
@@ -23,6 +23,7 @@
 #include "libmscore/mscore.h"
 
 #include <limits>
+#include <utility>
 #include <QtGlobal>
 
 namespace Ms {
@@ -110,6 +111,28 @@ static unsigned lcm(int a, int b)
     const int l = (a / g) * b;   // Divide first to minimize overflow risk
     return l >= 0 ? l : -l;
 }
+
+//---------------------------------------------------------
+//   compareFractions
+//    three-way comparison of n1/d1 and n2/d2 by 64-bit
+//    cross multiplication: no gcd, and it cannot overflow
+//    for int operands. Returns <0, 0 or >0
+//---------------------------------------------------------
+
+static int compareFractions(int n1, int d1, int n2, int d2)
+{
+    if (d1 == d2) {
+        // the most frequent case for the import: both values on the same tick grid
+        return d1 > 0 ? (n1 > n2) - (n1 < n2) : (n2 > n1) - (n2 < n1);
+    }
+
+    qint64 lhs = qint64(n1) * d2;
+    qint64 rhs = qint64(n2) * d1;
+    if ((d1 < 0) != (d2 < 0)) {
+        std::swap(lhs, rhs);
+    }
+    return (lhs > rhs) - (lhs < rhs);
+}
 }
 
 //-----------------------------------------------------------------------------
@@ -228,6 +251,16 @@ ReducedFraction& ReducedFraction::operator+=(const ReducedFraction& val)
     ReducedFraction value = val;
     value.preventOverflow();
 
+    if (denominator_ == val.denominator_ && denominator_ > 0) {
+        // same grid: the lcm is the denominator itself
+#ifdef QT_DEBUG
+        Q_ASSERT_X(!isAdditionOverflow(numerator_, val.numerator_),
+                   "ReducedFraction::operator+=", "Addition overflow");
+#endif
+        numerator_ += val.numerator_;
+        return *this;
+    }
+
     const int tmp = lcm(denominator_, val.denominator_);
     numerator_ = fractionPart(tmp, numerator_, denominator_)
                  + fractionPart(tmp, val.numerator_, val.denominator_);
@@ -241,6 +274,16 @@ ReducedFraction& ReducedFraction::operator-=(const ReducedFraction& val)
     ReducedFraction value = val;
     value.preventOverflow();
 
+    if (denominator_ == val.denominator_ && denominator_ > 0) {
+        // same grid: the lcm is the denominator itself
+#ifdef QT_DEBUG
+        Q_ASSERT_X(!isSubtractionOverflow(numerator_, val.numerator_),
+                   "ReducedFraction::operator-=", "Subtraction overflow");
+#endif
+        numerator_ -= val.numerator_;
+        return *this;
+    }
+
     const int tmp = lcm(denominator_, val.denominator_);
     numerator_ = fractionPart(tmp, numerator_, denominator_)
                  - fractionPart(tmp, val.numerator_, val.denominator_);
@@ -305,44 +348,32 @@ ReducedFraction& ReducedFraction::operator/=(int val)
 
 bool ReducedFraction::operator<(const ReducedFraction& val) const
 {
-    const int v = lcm(denominator_, val.denominator_);
-    return fractionPart(v, numerator_, denominator_)
-           < fractionPart(v, val.numerator_, val.denominator_);
+    return compareFractions(numerator_, denominator_, val.numerator_, val.denominator_) < 0;
 }
 
 bool ReducedFraction::operator<=(const ReducedFraction& val) const
 {
-    const int v = lcm(denominator_, val.denominator_);
-    return fractionPart(v, numerator_, denominator_)
-           <= fractionPart(v, val.numerator_, val.denominator_);
+    return compareFractions(numerator_, denominator_, val.numerator_, val.denominator_) <= 0;
 }
 
 bool ReducedFraction::operator>(const ReducedFraction& val) const
 {
-    const int v = lcm(denominator_, val.denominator_);
-    return fractionPart(v, numerator_, denominator_)
-           > fractionPart(v, val.numerator_, val.denominator_);
+    return compareFractions(numerator_, denominator_, val.numerator_, val.denominator_) > 0;
 }
 
 bool ReducedFraction::operator>=(const ReducedFraction& val) const
 {
-    const int v = lcm(denominator_, val.denominator_);
-    return fractionPart(v, numerator_, denominator_)
-           >= fractionPart(v, val.numerator_, val.denominator_);
+    return compareFractions(numerator_, denominator_, val.numerator_, val.denominator_) >= 0;
 }
 
 bool ReducedFraction::operator==(const ReducedFraction& val) const
 {
-    const int v = lcm(denominator_, val.denominator_);
-    return fractionPart(v, numerator_, denominator_)
-           == fractionPart(v, val.numerator_, val.denominator_);
+    return compareFractions(numerator_, denominator_, val.numerator_, val.denominator_) == 0;
 }
 
 bool ReducedFraction::operator!=(const ReducedFraction& val) const
 {
-    const int v = lcm(denominator_, val.denominator_);
-    return fractionPart(v, numerator_, denominator_)
-           != fractionPart(v, val.numerator_, val.denominator_);
+    return compareFractions(numerator_, denominator_, val.numerator_, val.denominator_) != 0;
 }
 
 //-------------------------------------------------------------------------
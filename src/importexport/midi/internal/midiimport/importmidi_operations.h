@@ -256,12 +256,13 @@ private:
 
     QString _currentMidiFile;
     QString _midiOperationsFile;
-    int _currentTrack = -1;
+    // per thread, so that tracks can be processed concurrently
+    static thread_local int _currentTrack;
 
     std::map<QString, FileData> _data;      // <file name, tracks data>
 };
 
-// scoped setter of current track
+// scoped setter of current track (for the calling thread only)
 class CurrentTrackSetter
 {
 public:
@@ -21,6 +21,7 @@
  */
 
 #include "testing/qtestsuite.h"
+#include "testing/qtestfilestiming.h"
 
 #include "testbase.h"
 
@@ -48,6 +49,10 @@
 #include "importexport/midiimport/internal/midiimport/importmidi_model.h"
 #include "importexport/midiimport/internal/midiimport/importmidi_lyrics.h"
 
+#include <limits>
+
+#include <QDir>
+
 //#include "mscore/preferences.h"
 
 namespace Ms {
@@ -186,6 +191,11 @@ private slots:
     // very short note - don't remove note but show it with min allowed duration (1/128)
     void chordVeryShort() { dontSimplify("chord_1_tick_long"); }
 
+    // time arithmetic
+    void reducedFractionCompare();
+    void reducedFractionEquivalence();
+    void importTiming();
+
     // test tuplet recognition functions
     void findChordInBar();
     void isTupletAllowed();
@@ -466,6 +476,120 @@ QString TestImportMidi::midiFilePath(const char* fileName) const
     return midiFilePath(QString(fileName));
 }
 
+//---------------------------------------------------------
+//  time arithmetic
+//---------------------------------------------------------
+
+void TestImportMidi::reducedFractionCompare()
+{
+    // same denominator
+    QVERIFY(ReducedFraction(1, 4) < ReducedFraction(3, 4));
+    QVERIFY(ReducedFraction(3, 4) >= ReducedFraction(3, 4));
+    QVERIFY(!(ReducedFraction(3, 4) != ReducedFraction(3, 4)));
+    // different denominators, unreduced values
+    QVERIFY(ReducedFraction(2, 4) == ReducedFraction(1, 2));
+    QVERIFY(ReducedFraction(1, 3) < ReducedFraction(1, 2));
+    QVERIFY(ReducedFraction(-1, 2) < ReducedFraction(1, 3));
+    QVERIFY(ReducedFraction::fromTicks(480) == ReducedFraction(1, 4));
+    // negative denominators
+    QVERIFY(ReducedFraction(1, -2) == ReducedFraction(-1, 2));
+    QVERIFY(ReducedFraction(1, -2) < ReducedFraction(1, 2));
+    QVERIFY(ReducedFraction(1, -4) > ReducedFraction(3, -4));
+    // large values do not overflow in comparison
+    QVERIFY(ReducedFraction(std::numeric_limits<int>::max(), 3)
+            > ReducedFraction(std::numeric_limits<int>::max() - 1, 3));
+    QVERIFY(ReducedFraction(std::numeric_limits<int>::max(), 7)
+            < ReducedFraction(std::numeric_limits<int>::max(), 5));
+
+    ReducedFraction sum(1, 8);
+    sum += ReducedFraction(3, 8);
+    QVERIFY(sum == ReducedFraction(1, 2));
+    sum -= ReducedFraction(1, 3);
+    QVERIFY(sum == ReducedFraction(1, 6));
+}
+
+//---------------------------------------------------------
+//  reducedFractionEquivalence
+//   the fast paths of comparison and same-grid arithmetic
+//   against the exact value, computed the slow way
+//---------------------------------------------------------
+
+static int referenceCompare(const ReducedFraction& a, const ReducedFraction& b)
+{
+    // a/b < c/d  <=>  a*d*b*d < c*b*b*d, both sides multiplied by (b*d)^2 > 0
+    const qint64 lhs = qint64(a.numerator()) * b.denominator() * a.denominator() * b.denominator();
+    const qint64 rhs = qint64(b.numerator()) * a.denominator() * a.denominator() * b.denominator();
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+void TestImportMidi::reducedFractionEquivalence()
+{
+    const std::vector<int> denominators = { 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 480, 1920, -1, -3, -4, -480 };
+
+    std::vector<ReducedFraction> values;
+    for (int d : denominators) {
+        for (int n = -24; n <= 24; ++n) {
+            values.push_back(ReducedFraction(n, d));
+        }
+    }
+
+    for (const ReducedFraction& a : values) {
+        for (const ReducedFraction& b : values) {
+            const int expected = referenceCompare(a, b);
+            QCOMPARE(a < b, expected < 0);
+            QCOMPARE(a <= b, expected <= 0);
+            QCOMPARE(a > b, expected > 0);
+            QCOMPARE(a >= b, expected >= 0);
+            QCOMPARE(a == b, expected == 0);
+            QCOMPARE(a != b, expected != 0);
+
+            ReducedFraction sum = a;
+            sum += b;
+            ReducedFraction difference = a;
+            difference -= b;
+
+            // exact values: a + b - a == b, a - b + b == a
+            QVERIFY(sum - a == b);
+            QVERIFY(difference + b == a);
+
+            if (a.denominator() == b.denominator() && a.denominator() > 0) {
+                // the same representation as the lcm path gives on one grid
+                QCOMPARE(sum.numerator(), a.numerator() + b.numerator());
+                QCOMPARE(sum.denominator(), a.denominator());
+                QCOMPARE(difference.numerator(), a.numerator() - b.numerator());
+                QCOMPARE(difference.denominator(), a.denominator());
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------
+//  importTiming
+//   import every MIDI file in the test data and report the time spent
+//   only runs if MIDI_IMPORT_TIMING is set, e.g. MIDI_IMPORT_TIMING=10 for ten rounds per file
+//   the output of each file is checked against its reference by the tests above
+//---------------------------------------------------------
+
+void TestImportMidi::importTiming()
+{
+    const mu::testing::QTestFilesTiming timing("MIDI_IMPORT_TIMING");
+    if (!timing.isEnabled()) {
+        QSKIP("set MIDI_IMPORT_TIMING to the number of rounds per file to run");
+    }
+
+    const QDir dataDir(QString(iex_midiimport_tests_DATA_ROOT) + "/" + MIDIIMPORT_DIR);
+    const QStringList files = dataDir.entryList({ "*.mid" }, QDir::Files, QDir::Name);
+
+    auto importFile = [this, &dataDir](const QString& file) {
+        MasterScore* score = new MasterScore(mscore->baseStyle());
+        importMidi(score, dataDir.filePath(file));
+        delete score;
+        return true;
+    };
+
+    timing.run(files, { { "import", importFile } });
+}
+
 //---------------------------------------------------------
 //  tuplet recognition functions
 //---------------------------------------------------------
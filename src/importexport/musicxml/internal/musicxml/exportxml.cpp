@@ -7169,6 +7169,7 @@ void ExportMusicXml::write(QIODevice* dev)
     writeParts();
 
     _xml.endObject();
+    _xml.flush();
 
     if (concertPitch) {
         // restore concert pitch
@@ -7225,7 +7226,7 @@ bool saveXml(Score* score, const QString& name)
 //     </rootfiles>
 // </container>
 
-static void writeMxlArchive(Score* score, MQZipWriter& zipwriter, const QString& filename)
+static bool writeMxlArchive(Score* score, MQZipWriter& zipwriter, const QString& filename)
 {
     QBuffer cbuf;
     cbuf.open(QIODevice::ReadWrite);
@@ -7245,12 +7246,19 @@ static void writeMxlArchive(Score* score, MQZipWriter& zipwriter, const QString&
     //uz.addDirectory("META-INF");
     zipwriter.addFile("META-INF/container.xml", cbuf.data());
 
-    QBuffer dbuf;
-    dbuf.open(QIODevice::ReadWrite);
-    ExportMusicXml em(score);
-    em.write(&dbuf);
-    dbuf.seek(0);
-    zipwriter.addFile(filename, dbuf.data());
+    // stream the score directly into the compressed entry,
+    // the uncompressed document is never held in memory as a whole
+    QIODevice* dev = zipwriter.openFile(filename);
+    if (!dev) {
+        return false;
+    }
+    {
+        ExportMusicXml em(score);
+        em.write(dev);
+    }
+    dev->close();
+
+    return zipwriter.status() == MQZipWriter::NoError;
 }
 
 bool saveMxl(Score* score, QIODevice* device)
@@ -7259,10 +7267,10 @@ bool saveMxl(Score* score, QIODevice* device)
 
     //anonymized filename since we don't know the actual one here
     QString fn = "score.xml";
-    writeMxlArchive(score, uz, fn);
+    bool ok = writeMxlArchive(score, uz, fn);
     uz.close();
 
-    return true;
+    return ok && uz.status() == MQZipWriter::NoError;
 }
 
 bool saveMxl(Score* score, const QString& name)
@@ -7271,9 +7279,10 @@ bool saveMxl(Score* score, const QString& name)
 
     QFileInfo fi(name);
     QString fn = fi.completeBaseName() + ".xml";
-    writeMxlArchive(score, uz, fn);
+    bool ok = writeMxlArchive(score, uz, fn);
+    uz.close();
 
-    return true;
+    return ok && uz.status() == MQZipWriter::NoError;
 }
 
 double ExportMusicXml::getTenthsFromInches(double inches) const
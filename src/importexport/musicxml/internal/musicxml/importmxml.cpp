@@ -52,7 +52,13 @@ static int musicXMLImportErrorDialog(QString text, QString detailedText)
 //   importMusicXMLfromBuffer
 //---------------------------------------------------------
 
-Score::FileError importMusicXMLfromBuffer(Score* score, const QString& /*name*/, QIODevice* dev)
+/**
+ Import MusicXML data from \a dev into \a score. If given, \a afterPass1 is
+ called once pass 1 succeeded, pass 2 is skipped if it returns an error.
+ */
+
+Score::FileError importMusicXMLfromBuffer(Score* score, const QString& /*name*/, QIODevice* dev,
+                                          const std::function<Score::FileError()>& afterPass1)
 {
     //qDebug("importMusicXMLfromBuffer(score %p, name '%s', dev %p)",
     //       score, qPrintable(name), dev);
@@ -68,6 +74,10 @@ Score::FileError importMusicXMLfromBuffer(Score* score, const QString& /*name*/,
     Score::FileError res = pass1.parse(dev);
     const auto pass1_errors = pass1.errors();
 
+    if (res == Score::FileError::FILE_NO_ERROR && afterPass1) {
+        res = afterPass1();
+    }
+
     // pass 2
     MusicXMLParserPass2 pass2(score, pass1, &logger);
     if (res == Score::FileError::FILE_NO_ERROR) {
@@ -23,12 +23,15 @@
 #ifndef __IMPORTMXML_H__
 #define __IMPORTMXML_H__
 
+#include <functional>
+
 #include "libmscore/masterscore.h"
 #include "importxmlfirstpass.h"
 #include "musicxml.h" // for the creditwords definition
 #include "musicxmlsupport.h"
 
 namespace Ms {
-Score::FileError importMusicXMLfromBuffer(Score* score, const QString&, QIODevice* dev);
+Score::FileError importMusicXMLfromBuffer(Score* score, const QString&, QIODevice* dev,
+                                          const std::function<Score::FileError()>& afterPass1 = nullptr);
 } // namespace Ms
 #endif
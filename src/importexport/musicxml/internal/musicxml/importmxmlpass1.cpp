@@ -378,7 +378,7 @@ void MusicXMLParserPass1::setDrumsetDefault(const QString& id,
 bool MusicXMLParserPass1::determineStaffMoveVoice(const QString& id, const int mxStaff, const QString& mxVoice,
                                                   int& msMove, int& msTrack, int& msVoice) const
 {
-    VoiceList voicelist = getVoiceList(id);
+    const VoiceList& voicelist = musicXmlPart(id).voicelist;
     msMove = 0;   // TODO
     msTrack = 0;   // TODO
     msVoice = 0;   // TODO
@@ -447,6 +447,22 @@ bool MusicXMLParserPass1::hasPart(const QString& id) const
     return _parts.contains(id);
 }
 
+//---------------------------------------------------------
+//   musicXmlPart
+//---------------------------------------------------------
+
+/**
+ Return a reference to the MusicXmlPart for part \a id, avoiding the copy
+ made by getMusicXmlPart(). Return an empty MusicXmlPart if not found.
+ */
+
+const MusicXmlPart& MusicXMLParserPass1::musicXmlPart(const QString& id) const
+{
+    static const MusicXmlPart emptyPart;
+    auto it = _parts.constFind(id);
+    return it != _parts.cend() ? it.value() : emptyPart;
+}
+
 //---------------------------------------------------------
 //   trackForPart
 //---------------------------------------------------------
@@ -493,7 +509,7 @@ Fraction MusicXMLParserPass1::getMeasureStart(const int i) const
 int MusicXMLParserPass1::octaveShift(const QString& id, const int staff, const Fraction f) const
 {
     if (_parts.contains(id)) {
-        return _parts.value(id).octaveShift(staff, f);
+        return musicXmlPart(id).octaveShift(staff, f);
     }
 
     return 0;
@@ -161,6 +161,7 @@ public:
     bool hasPart(const QString& id) const;
     Part* getPart(const QString& id) const { return _partMap.value(id); }
     MusicXmlPart getMusicXmlPart(const QString& id) const { return _parts.value(id); }
+    const MusicXmlPart& musicXmlPart(const QString& id) const;
     MusicXMLInstruments getInstruments(const QString& id) const { return _instruments.value(id); }
     void setDrumsetDefault(const QString& id, const QString& instrId, const NoteHead::Group hg, const int line, const DirectionV sd);
     MusicXmlInstrList getInstrList(const QString id) const;
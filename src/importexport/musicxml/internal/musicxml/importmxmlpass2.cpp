@@ -1433,6 +1433,7 @@ void MusicXMLParserPass2::initPartState(const QString& partId)
     _extendedLyrics.init();
 
     _nstaves = _pass1.getPart(partId)->nstaves();
+    _partTrack = _pass1.trackForPart(partId);
     _measureRepeatNumMeasures.assign(_nstaves, 0);
     _measureRepeatCount.assign(_nstaves, 0);
 }
@@ -1596,6 +1597,13 @@ Score::FileError MusicXMLParserPass2::parse()
 
 void MusicXMLParserPass2::scorePartwise()
 {
+    // pass 2 doesn't add measures: look them up by tick instead of
+    // walking the measure list for every measure of every part
+    _measuresByTick.clear();
+    for (Measure* m = _score->firstMeasure(); m; m = m->nextMeasure()) {
+        _measuresByTick.emplace(m->tick(), m);
+    }
+
     while (_e.readNextStartElement()) {
         if (_e.name() == "part") {
             part();
@@ -2008,7 +2016,8 @@ void MusicXMLParserPass2::measure(const QString& partId, const Fraction time)
 
     //qDebug("measure %d start", parsedMeasureNumber);
 
-    Measure* measure = findMeasure(_score, time);
+    const auto it = _measuresByTick.find(time);
+    Measure* measure = it != _measuresByTick.end() ? it->second : findMeasure(_score, time);
     if (!measure) {
         _logger->logError(QString("measure at tick %1 not found!").arg(time.ticks()), &_e);
         skipLogCurrElem();
@@ -4467,7 +4476,7 @@ Note* MusicXMLParserPass2::note(const QString& partId,
     bool printObject = _e.attributes().value("print-object") != "no";
     BeamMode bm  = BeamMode::AUTO;
     QString instrumentId;
-    MusicXMLParserLyric lyric { _pass1.getMusicXmlPart(partId).lyricNumberHandler(), _e, _score, _logger };
+    MusicXMLParserLyric lyric { _pass1.musicXmlPart(partId).lyricNumberHandler(), _e, _score, _logger };
     MusicXMLParserNotations notations { _e, _score, _logger };
 
     mxmlNoteDuration mnd { _divs, _logger };
@@ -4650,7 +4659,7 @@ Note* MusicXMLParserPass2::note(const QString& partId,
             }
         }
         note = Factory::createNote(c);
-        const int ottavaStaff = (msTrack - _pass1.trackForPart(partId)) / VOICES;
+        const int ottavaStaff = (msTrack - _partTrack) / VOICES;
         const int octaveShift = _pass1.octaveShift(partId, ottavaStaff, noteStartTime);
         const auto part = _pass1.getPart(partId);
         const auto instrument = part->instrument(noteStartTime);
@@ -5360,7 +5369,7 @@ void MusicXMLParserPass2::backup(Fraction& dura)
 //   MusicXMLParserLyric
 //---------------------------------------------------------
 
-MusicXMLParserLyric::MusicXMLParserLyric(const LyricNumberHandler lyricNumberHandler,
+MusicXMLParserLyric::MusicXMLParserLyric(const LyricNumberHandler& lyricNumberHandler,
                                          QXmlStreamReader& e, Score* score, MxmlLogger* logger)
     : _lyricNumberHandler(lyricNumberHandler), _e(e), _score(score), _logger(logger)
 {
@@ -24,6 +24,7 @@
 #define __IMPORTMXMLPASS2_H__
 
 #include <array>
+#include <map>
 
 #include "libmscore/masterscore.h"
 #include "libmscore/tuplet.h"
@@ -128,13 +129,13 @@ private:
 class MusicXMLParserLyric
 {
 public:
-    MusicXMLParserLyric(const LyricNumberHandler lyricNumberHandler, QXmlStreamReader& e, Score* score, MxmlLogger* logger);
+    MusicXMLParserLyric(const LyricNumberHandler& lyricNumberHandler, QXmlStreamReader& e, Score* score, MxmlLogger* logger);
     QSet<Lyrics*> extendedLyrics() const { return _extendedLyrics; }
     QMap<int, Lyrics*> numberedLyrics() const { return _numberedLyrics; }
     void parse();
 private:
     void skipLogCurrElem();
-    const LyricNumberHandler _lyricNumberHandler;
+    const LyricNumberHandler& _lyricNumberHandler;
     QXmlStreamReader& _e;
     Score* const _score;                        // the score
     MxmlLogger* _logger;                        ///< Error logger
@@ -342,11 +343,13 @@ private:
     FiguredBass* _figBass;                        ///< Current figured bass element (to attach to next note)
     int _multiMeasureRestCount;
     int _measureNumber;                           ///< Current measure number as written in the score
+    std::map<Fraction, Measure*> _measuresByTick; ///< Measures created in pass 1, by start tick
     MusicXmlLyricsExtend _extendedLyrics;         ///< Lyrics with "extend" requiring fixup
 
     MusicXmlSlash _measureStyleSlash;             ///< Are we inside a measure to be displayed as slashes?
 
     int _nstaves;                                 ///< Number of staves in current part
+    int _partTrack;                               ///< Track of the first staff of current part
     std::vector<int> _measureRepeatNumMeasures;
     std::vector<int> _measureRepeatCount;
 };
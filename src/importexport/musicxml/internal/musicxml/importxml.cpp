@@ -28,10 +28,26 @@
 #include <QXmlSchema>
 #include <QXmlSchemaValidator>
 #include <QBuffer>
+#include <QMutex>
+#include <QtConcurrent>
 
 #include "thirdparty/qzip/qzipreader_p.h"
 #include "importmxml.h"
 
+#include "modularity/ioc.h"
+#include "importexport/musicxml/imusicxmlconfiguration.h"
+
+static std::shared_ptr<mu::iex::musicxml::IMusicXmlConfiguration> configuration()
+{
+    return mu::modularity::ioc()->resolve<mu::iex::musicxml::IMusicXmlConfiguration>("iex_musicxml");
+}
+
+static bool musicxmlStreamingValidation()
+{
+    auto conf = configuration();
+    return conf ? conf->musicxmlStreamingValidation() : false;
+}
+
 namespace Ms {
 //---------------------------------------------------------
 //   tupletAssert -- check assertions for tuplet handling
@@ -181,37 +197,96 @@ static bool extractRootfile(QFile* qf, QByteArray& data)
 }
 
 //---------------------------------------------------------
-//   doValidate
+//   musicXmlSchema
 //---------------------------------------------------------
 
 /**
- Validate MusicXML data from file \a name contained in QIODevice \a dev.
+ Return the compiled MusicXML schema, or nullptr if it could not be loaded.
+ The schema is compiled on first use only and shared by all subsequent imports.
+ QXmlSchema is not thread-safe, callers must hold musicXmlSchemaMutex.
  */
 
-static Score::FileError doValidate(const QString& name, QIODevice* dev)
+static QMutex musicXmlSchemaMutex;
+
+static const QXmlSchema* musicXmlSchema()
+{
+    // intentionally never deleted, it must outlive the imports
+    static const QXmlSchema* schema = []() -> const QXmlSchema* {
+        QXmlSchema* s = new QXmlSchema();
+        if (!initMusicXmlSchema(*s)) {
+            delete s;
+            return nullptr;
+        }
+        return s;
+    }();
+    return schema;
+}
+
+//---------------------------------------------------------
+//   ValidationResult
+//---------------------------------------------------------
+
+struct ValidationResult {
+    bool schemaValid = false;
+    bool valid = false;
+    QString errors;
+};
+
+//---------------------------------------------------------
+//   validate
+//---------------------------------------------------------
+
+/**
+ Validate MusicXML data from file \a name contained in QIODevice \a dev
+ against the cached schema. May be called from any thread.
+ */
+
+static ValidationResult validate(const QString& name, QIODevice* dev)
 {
     //QElapsedTimer t;
     //t.start();
 
-    // initialize the schema
+    ValidationResult result;
+
+    QMutexLocker locker(&musicXmlSchemaMutex);
+    const QXmlSchema* schema = musicXmlSchema();
+    if (!schema) {
+        return result;
+    }
+    result.schemaValid = true;
+
     ValidatorMessageHandler messageHandler;
-    QXmlSchema schema;
-    schema.setMessageHandler(&messageHandler);
-    if (!initMusicXmlSchema(schema)) {
+    QXmlSchemaValidator validator(*schema);
+    validator.setMessageHandler(&messageHandler);
+    result.valid = validator.validate(dev, QUrl::fromLocalFile(name));
+    result.errors = messageHandler.getErrors();
+    //qDebug("Validation time elapsed: %d ms", t.elapsed());
+
+    return result;
+}
+
+//---------------------------------------------------------
+//   validationResultToError
+//---------------------------------------------------------
+
+/**
+ Report the validation \a result for file \a name and ask the user
+ whether to continue if the file is not valid.
+ */
+
+static Score::FileError validationResultToError(const QString& name, const ValidationResult& result)
+{
+    if (!result.schemaValid) {
         return Score::FileError::FILE_BAD_FORMAT;      // appropriate error message has been printed by initMusicXmlSchema
     }
-    // validate the data
-    QXmlSchemaValidator validator(schema);
-    bool valid = validator.validate(dev, QUrl::fromLocalFile(name));
-    //qDebug("Validation time elapsed: %d ms", t.elapsed());
 
-    if (!valid) {
+    if (!result.valid) {
         qDebug("importMusicXml() file '%s' is not a valid MusicXML file", qPrintable(name));
         MScore::lastError = QObject::tr("File '%1' is not a valid MusicXML file").arg(name);
         if (MScore::noGui) {
             return Score::FileError::FILE_NO_ERROR;         // might as well try anyhow in converter mode
         }
-        if (musicXMLValidationErrorDialog(MScore::lastError, messageHandler.getErrors()) != QMessageBox::Yes) {
+        if (musicXMLValidationErrorDialog(MScore::lastError, result.errors) != QMessageBox::Yes) {
             return Score::FileError::FILE_USER_ABORT;
         }
     }
@@ -220,6 +295,51 @@ static Score::FileError doValidate(const QString& name, QIODevice* dev)
     return Score::FileError::FILE_NO_ERROR;
 }
 
+//---------------------------------------------------------
+//   doValidate
+//---------------------------------------------------------
+
+/**
+ Validate MusicXML data from file \a name contained in QIODevice \a dev.
+ */
+
+static Score::FileError doValidate(const QString& name, QIODevice* dev)
+{
+    return validationResultToError(name, validate(name, dev));
+}
+
+//---------------------------------------------------------
+//   doStreamingValidateAndImport
+//---------------------------------------------------------
+
+/**
+ Import MusicXML data from file \a name contained in QIODevice \a dev into score \a score,
+ validating it on a worker thread while pass 1 reads the same data.
+ The validation result is checked before pass 2 starts.
+ */
+
+static Score::FileError doStreamingValidateAndImport(Score* score, const QString& name, QIODevice* dev)
+{
+    dev->seek(0);
+    QByteArray data = dev->readAll();
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+
+    QFuture<ValidationResult> validation = QtConcurrent::run([name, data]() {
+        QBuffer validationBuffer;
+        validationBuffer.setData(data);
+        validationBuffer.open(QIODevice::ReadOnly);
+        return validate(name, &validationBuffer);
+    });
+
+    Score::FileError res = importMusicXMLfromBuffer(score, name, &buffer, [&]() {
+        return validationResultToError(name, validation.result());
+    });
+
+    validation.waitForFinished();
+    return res;
+}
+
 //---------------------------------------------------------
 //   doValidateAndImport
 //---------------------------------------------------------
@@ -233,6 +353,10 @@ static Score::FileError doValidateAndImport(Score* score, const QString& name, Q
     // verify tuplet TDuration::DurationType dependencies
     tupletAssert();
 
+    if (musicxmlStreamingValidation()) {
+        return doStreamingValidateAndImport(score, name, dev);
+    }
+
     // validate the file
     Score::FileError res;
     res = doValidate(name, dev);
@@ -36,6 +36,9 @@ public:
     bool musicxmlImportLayout() const override;
     void setMusicxmlImportLayout(bool value) override;
 
+    bool musicxmlStreamingValidation() const override;
+    void setMusicxmlStreamingValidation(bool value) override;
+
     bool musicxmlExportLayout() const override;
     void setMusicxmlExportLayout(bool value) override;
 
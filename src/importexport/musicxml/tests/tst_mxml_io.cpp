@@ -21,6 +21,10 @@
  */
 
 #include "testing/qtestsuite.h"
+#include "testing/qtestfilestiming.h"
+
+#include <map>
+#include <memory>
 
 #include "testbase.h"
 
@@ -32,6 +36,8 @@
 #include "libmscore/keysig.h"
 // end includes required for fixupScore()
 
+#include "engraving/compat/scoreaccess.h"
+
 #include "settings.h"
 #include "importexport/musicxml/imusicxmlconfiguration.h"
 
@@ -41,6 +47,8 @@ using namespace mu::iex::musicxml;
 
 namespace Ms {
 extern bool saveMxl(Score*, const QString&);
+extern bool saveXml(Score*, const QString&);
+extern Score::FileError importMusicXml(MasterScore*, const QString&);
 }
 
 static const QString XML_IO_DATA_DIR("data/");
@@ -49,6 +57,7 @@ static const std::string MODULE_NAME("importexport");
 
 static const std::string PREF_EXPORT_MUSICXML_EXPORTBREAKS("export/musicXML/exportBreaks");
 static const std::string PREF_IMPORT_MUSICXML_IMPORTBREAKS("import/musicXML/importBreaks");
+static const std::string PREF_IMPORT_MUSICXML_STREAMINGVALIDATION("import/musicXML/streamingValidation");
 static const std::string PREF_EXPORT_MUSICXML_EXPORTLAYOUT("export/musicXML/exportLayout");
 static const std::string PREF_EXPORT_MUSICXML_EXPORTINVISIBLE("export/musicXML/exportInvisibleElements");
 
@@ -71,6 +80,7 @@ class TestMxmlIO : public QObject, public MTest
     void mxmlReadTestCompr(const char* file);
     void mxmlReadWriteTestCompr(const char* file);
     void mxmlImportTestRef(const char* file);
+    void mxmlIoTestStreamingValidation(const char* file);
 
     // The list of MusicXML regression tests
     // Currently failing tests are commented out and annotated with the failure reason
@@ -140,6 +150,7 @@ private slots:
     void hello() { mxmlIoTest("testHello"); }
     void helloReadCompr() { mxmlReadTestCompr("testHello"); }
     void helloReadWriteCompr() { mxmlReadWriteTestCompr("testHello"); }
+    void helloWriteComprFailure();
     void implicitMeasure1() { mxmlIoTest("testImplicitMeasure1"); }
     void incorrectStaffNumber1() { mxmlIoTestRef("testIncorrectStaffNumber1"); }
     void incorrectStaffNumber2() { mxmlIoTestRef("testIncorrectStaffNumber2"); }
@@ -199,6 +210,7 @@ private slots:
     void sound2() { mxmlIoTestRef("testSound2"); }
     void specialCharacters() { mxmlIoTest("testSpecialCharacters"); }
     void staffTwoKeySigs() { mxmlIoTest("testStaffTwoKeySigs"); }
+    void streamingValidation() { mxmlIoTestStreamingValidation("testDirections1"); }
     void stringVoiceName() { mxmlIoTestRef("testStringVoiceName"); }
     void systemBrackets1() { mxmlIoTest("testSystemBrackets1"); }
     void systemBrackets2() { mxmlIoTest("testSystemBrackets2"); }
@@ -245,6 +257,9 @@ private slots:
     void words1() { mxmlIoTest("testWords1"); }
     void words2() { mxmlIoTest("testWords2"); }
     void excludeInvisibleElements() { mxmlMscxExportTestRefInvisibleElements("testExcludeInvisibleElements"); }
+
+    void importTiming();
+    void exportTiming();
 };
 
 //---------------------------------------------------------
@@ -297,6 +312,18 @@ void TestMxmlIO::mxmlIoTest(const char* file)
     delete score;
 }
 
+//---------------------------------------------------------
+//   mxmlIoTestStreamingValidation
+//   same as mxmlIoTest, but validate while importing
+//---------------------------------------------------------
+
+void TestMxmlIO::mxmlIoTestStreamingValidation(const char* file)
+{
+    setValue(PREF_IMPORT_MUSICXML_STREAMINGVALIDATION, Val(true));
+    mxmlIoTest(file);
+    setValue(PREF_IMPORT_MUSICXML_STREAMINGVALIDATION, Val(false));
+}
+
 //---------------------------------------------------------
 //   mxmlIoTestRef
 //   read a MusicXML file, write to a new file and verify against reference
@@ -492,6 +519,22 @@ void TestMxmlIO::mxmlReadWriteTestCompr(const char* file)
     delete score;
 }
 
+//---------------------------------------------------------
+//   helloWriteComprFailure
+//   writing a compressed MusicXML file where it cannot be created must fail
+//---------------------------------------------------------
+
+void TestMxmlIO::helloWriteComprFailure()
+{
+    MScore::debugMode = false;
+
+    MasterScore* score = readScore(XML_IO_DATA_DIR + "testHello.xml");
+    QVERIFY(score);
+    score->doLayout();
+    QVERIFY(!saveMxl(score, "nonexistent_directory/testHello.mxl"));
+    delete score;
+}
+
 //---------------------------------------------------------
 //   mxmlImportTestRef
 //   read a MusicXML file, write to a new MuseScore mscx file
@@ -512,5 +555,78 @@ void TestMxmlIO::mxmlImportTestRef(const char* file)
     delete score;
 }
 
+//---------------------------------------------------------
+//   importTiming
+//   import every MusicXML file in the test data and report the time spent
+//   only runs if MXML_IMPORT_TIMING is set, e.g. MXML_IMPORT_TIMING=10 for ten rounds per file
+//---------------------------------------------------------
+
+void TestMxmlIO::importTiming()
+{
+    const mu::testing::QTestFilesTiming timing("MXML_IMPORT_TIMING");
+    if (!timing.isEnabled()) {
+        QSKIP("set MXML_IMPORT_TIMING to the number of rounds per file to run");
+    }
+
+    MScore::debugMode = false;
+    setValue(PREF_IMPORT_MUSICXML_IMPORTBREAKS, Val(true));
+
+    const QDir dataDir(root + "/" + XML_IO_DATA_DIR);
+    const QStringList files = dataDir.entryList({ "*.xml" }, QDir::Files, QDir::Name);
+
+    auto importFile = [&dataDir](const QString& file) {
+        MasterScore* score = mu::engraving::compat::ScoreAccess::createMasterScoreWithBaseStyle();
+        ScoreLoad sl;
+        importMusicXml(score, dataDir.filePath(file));
+        delete score;
+        return true;
+    };
+
+    timing.run(files, { { "import", importFile } });
+}
+
+//---------------------------------------------------------
+//   exportTiming
+//   export every MusicXML file in the test data as .xml and .mxl and report the time spent
+//   only runs if MXML_EXPORT_TIMING is set, e.g. MXML_EXPORT_TIMING=10 for ten rounds per file
+//---------------------------------------------------------
+
+void TestMxmlIO::exportTiming()
+{
+    const mu::testing::QTestFilesTiming timing("MXML_EXPORT_TIMING");
+    if (!timing.isEnabled()) {
+        QSKIP("set MXML_EXPORT_TIMING to the number of rounds per file to run");
+    }
+
+    MScore::debugMode = false;
+    setValue(PREF_EXPORT_MUSICXML_EXPORTLAYOUT, Val(true));
+
+    const QDir dataDir(root + "/" + XML_IO_DATA_DIR);
+
+    //! NOTE The scores are read and laid out before, only the export is timed
+    QStringList files;
+    std::map<QString, std::unique_ptr<MasterScore> > scores;
+    for (const QString& file : dataDir.entryList({ "*.xml" }, QDir::Files, QDir::Name)) {
+        MasterScore* score = readScore(XML_IO_DATA_DIR + file);
+        if (!score) {
+            continue;
+        }
+        fixupScore(score);
+        score->doLayout();
+
+        files << file;
+        scores[file].reset(score);
+    }
+
+    auto exportXml = [&scores](const QString& file) {
+        return saveXml(scores.at(file).get(), "export_timing.xml");
+    };
+    auto exportMxl = [&scores](const QString& file) {
+        return saveMxl(scores.at(file).get(), "export_timing.mxl");
+    };
+
+    timing.run(files, { { "xml", exportXml }, { "mxl", exportMxl } });
+}
+
 QTEST_MAIN(TestMxmlIO)
 #include "tst_mxml_io.moc"
@@ -46,6 +46,13 @@ public:
                                         const midi::tick_t toTick) const = 0;
     virtual midi::Events retrieveEventsForElement(const EngravingItem* element, const midi::channel_t midiChannel) const = 0;
     virtual std::vector<midi::Event> retrieveSetupEvents(const std::list<InstrumentChannel*> instrChannel) const = 0;
+
+    //! NOTE Renders the events from the given ticks (and from the rehearsal marks) in the background
+    //! and sends them to the tracks, so that seeking to them doesn't wait for the rendering
+    virtual void prefetchEvents(const std::vector<midi::tick_t>& ticks) = 0;
+
+    //! NOTE Sends the events prefetched so far to the track of the part, which was added after they were sent
+    virtual void resendPrefetchedEvents(const ID& partId) = 0;
 };
 
 using IMasterNotationMidiDataPtr = std::shared_ptr<IMasterNotationMidiData>;
@@ -140,6 +140,9 @@ public:
     virtual int notePlayDurationMilliseconds() const = 0;
     virtual void setNotePlayDurationMilliseconds(int durationMs) = 0;
 
+    virtual int undoHistoryMemoryLimitMegabytes() const = 0;
+    virtual void setUndoHistoryMemoryLimitMegabytes(int limitMb) = 0;
+
     virtual void setTemplateModeEnalbed(bool enabled) = 0;
     virtual void setTestModeEnabled(bool enabled) = 0;
 
@@ -31,45 +31,58 @@ using namespace mu::notation;
 void InstrumentsRepository::init()
 {
     configuration()->instrumentListPathsChanged().onNotify(this, [this]() {
-        load();
+        reset();
     });
 
     configuration()->scoreOrderListPathsChanged().onNotify(this, [this]() {
-        load();
+        reset();
     });
 
-    load();
+    reset();
 }
 
 const InstrumentTemplateList& InstrumentsRepository::instrumentTemplates() const
 {
+    Ms::ensureInstrumentTemplatesLoaded();
     return m_instrumentTemplates;
 }
 
 const InstrumentGenreList& InstrumentsRepository::genres() const
 {
+    Ms::ensureInstrumentTemplatesLoaded();
     return m_genres;
 }
 
 const InstrumentGroupList& InstrumentsRepository::groups() const
 {
+    Ms::ensureInstrumentTemplatesLoaded();
     return m_groups;
 }
 
 const ScoreOrderList& InstrumentsRepository::orders() const
 {
+    Ms::ensureInstrumentTemplatesLoaded();
     return Ms::instrumentOrders;
 }
 
-void InstrumentsRepository::load()
+//! NOTE Parsing the instrument lists is expensive and not needed at all in many cases
+//! (e.g. converting a score), so they are loaded on first use only
+void InstrumentsRepository::reset()
 {
-    TRACEFUNC;
-
     m_instrumentTemplates.clear();
     m_genres.clear();
     m_groups.clear();
     Ms::clearInstrumentTemplates();
 
+    Ms::setInstrumentTemplatesLoader([this]() {
+        load();
+    });
+}
+
+void InstrumentsRepository::load()
+{
+    TRACEFUNC;
+
     for (const io::path& filePath: configuration()->instrumentListPaths()) {
         if (!Ms::loadInstrumentTemplates(filePath.toQString())) {
             LOGE() << "Could not load instruments from " << filePath.toQString() << "!";
@@ -44,8 +44,8 @@ public:
     const ScoreOrderList& orders() const override;
 
 private:
+    void reset();
     void load();
-    void clear();
 
     InstrumentTemplateList m_instrumentTemplates;
     InstrumentGroupList m_groups;
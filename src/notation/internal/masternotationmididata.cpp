@@ -22,9 +22,15 @@
 
 #include "masternotationmididata.h"
 
+#include <algorithm>
+
 #include "engraving/libmscore/repeatlist.h"
+#include "engraving/libmscore/segment.h"
 #include "engraving/libmscore/tempo.h"
+#include "engraving/libmscore/undo.h"
+#include "engraving/types/constants.h"
 
+#include "async/async.h"
 #include "log.h"
 
 #include "notationerrors.h"
@@ -33,15 +39,31 @@ using namespace mu;
 using namespace mu::notation;
 using namespace mu::midi;
 
+static const tick_t PREFETCH_RANGE_TICKS = mu::engraving::Constants::division * 4 * 10; // about 10 measures of 4/4 time signature, as much as a track requests at once
+
 MasterNotationMidiData::MasterNotationMidiData(IGetScore* getScore, async::Notification notationChanged)
     : m_getScore(getScore)
 {
     notationChanged.onNotify(this, [this]() {
-        m_renderRanges.clear();
-        m_eventsCache.clear();
         if (m_midiRenderImpl) {
             m_midiRenderImpl->setScoreChanged();
+
+            //! NOTE The notification comes on any change of the notation (layout, dragging, style...),
+            //! after undoable edits the rendered events stay valid while the measures they were rendered from are unchanged.
+            //! Changes bypassing the undo stack can't be attributed to measures, everything is rendered again
+            const uint64_t contentChangesCount = score()->undoStack()->contentChangesCount();
+            const bool undoableChanges = contentChangesCount != m_contentChangesCount;
+            m_contentChangesCount = contentChangesCount;
+
+            if (!undoableChanges) {
+                m_midiRenderImpl->setContentChanged();
+            } else if (m_midiRenderImpl->changedChunks().empty()) {
+                return;
+            }
         }
+        m_renderRanges.clear();
+        m_eventsCache.clear();
+        invalidatePrefetchedEvents();
     });
 }
 
@@ -49,6 +71,7 @@ MasterNotationMidiData::~MasterNotationMidiData()
 {
     for (auto& midiData : m_midiDataMap) {
         midiData.second.stream.eventsRequest.resetOnReceive(this);
+        midiData.second.stream.prefetchReleased.resetOnNotify(this);
     }
     m_parts = nullptr;
 }
@@ -61,6 +84,7 @@ void MasterNotationMidiData::init(INotationPartsPtr parts)
 
     m_parts = std::move(parts);
     m_midiRenderImpl = std::unique_ptr<Ms::MidiRenderer>(new Ms::MidiRenderer(score()));
+    m_contentChangesCount = score()->undoStack()->contentChangesCount();
 
     m_midiDataMap.clear();
 
@@ -190,6 +214,167 @@ Events MasterNotationMidiData::eventsFromRange(const std::vector<channel_t>& mid
     return result;
 }
 
+void MasterNotationMidiData::prefetchEvents(const std::vector<tick_t>& ticks)
+{
+    //! NOTE The ranges prefetched before stay valid until the content changes, only the new ticks need rendering
+    if (ticks == m_requestedPrefetchTicks) {
+        return;
+    }
+
+    m_requestedPrefetchTicks = ticks;
+    schedulePrefetch();
+}
+
+void MasterNotationMidiData::resendPrefetchedEvents(const ID& partId)
+{
+    if (!m_parts) {
+        return;
+    }
+
+    auto search = m_midiDataMap.find(partId);
+    if (search == m_midiDataMap.end()) {
+        return;
+    }
+
+    for (const Part* part : m_parts->partList()) {
+        if (part->id() != partId) {
+            continue;
+        }
+
+        //! NOTE It is cheap, the rendered events are cached
+        for (const TicksRange& range : m_prefetchedRanges) {
+            sendPrefetchedEvents(part, search->second, range);
+        }
+
+        return;
+    }
+}
+
+std::vector<tick_t> MasterNotationMidiData::prefetchTicks() const
+{
+    std::vector<tick_t> result;
+
+    const Ms::MasterScore* score = masterScore();
+    if (!score || !score->lastMeasure()) {
+        return result;
+    }
+
+    const tick_t lastTick = score->lastMeasure()->endTick().ticks() - 1;
+    auto addTick = [&result, lastTick](const tick_t tick) {
+        if (tick < lastTick) {
+            result.push_back(tick);
+        }
+    };
+
+    //! NOTE The requested ticks (playback cursor, loop) go first, they are most likely to be played soon
+    for (const tick_t tick : m_requestedPrefetchTicks) {
+        addTick(tick);
+    }
+
+    addTick(0);
+
+    for (const Ms::Segment* s = score->firstSegment(Ms::SegmentType::ChordRest); s; s = s->next1(Ms::SegmentType::ChordRest)) {
+        for (const EngravingItem* e : s->annotations()) {
+            if (e->isRehearsalMark()) {
+                addTick(score->repeatList().tick2utick(s->tick().ticks()));
+                break;
+            }
+        }
+    }
+
+    return result;
+}
+
+void MasterNotationMidiData::schedulePrefetch()
+{
+    if (m_isPrefetchScheduled) {
+        return;
+    }
+
+    m_isPrefetchScheduled = true;
+
+    //! NOTE One range is rendered at a time, so that the UI stays responsive in between
+    async::Async::call(this, [this]() {
+        m_isPrefetchScheduled = false;
+        prefetchNextRange();
+    });
+}
+
+void MasterNotationMidiData::prefetchNextRange()
+{
+    if (!m_parts || !masterScore() || !masterScore()->lastMeasure()) {
+        return;
+    }
+
+    auto isPrefetched = [this](const tick_t tick) {
+        return std::any_of(m_prefetchedRanges.cbegin(), m_prefetchedRanges.cend(), [tick](const TicksRange& range) {
+            return tick >= range.start && tick < range.end;
+        });
+    };
+
+    std::vector<tick_t> ticks = prefetchTicks();
+    auto it = std::find_if_not(ticks.cbegin(), ticks.cend(), isPrefetched);
+    if (it == ticks.cend()) {
+        return;
+    }
+
+    const tick_t lastTick = masterScore()->lastMeasure()->endTick().ticks() - 1;
+
+    TicksRange range;
+    range.start = *it;
+    range.end = std::min(lastTick, range.start + PREFETCH_RANGE_TICKS);
+
+    for (const Part* part : m_parts->partList()) {
+        auto search = m_midiDataMap.find(part->id());
+        if (search == m_midiDataMap.end()) {
+            continue;
+        }
+
+        sendPrefetchedEvents(part, search->second, range);
+    }
+
+    m_prefetchedRanges.push_back(std::move(range));
+
+    schedulePrefetch();
+}
+
+void MasterNotationMidiData::sendPrefetchedEvents(const Part* part, MidiData& midiData, const TicksRange& range) const
+{
+    auto prefetched = std::make_shared<PrefetchedEvents>();
+    prefetched->from = range.start;
+    prefetched->to = range.end;
+    prefetched->events = retrieveEvents(partMidiChannels(part), range.start, range.end);
+    prefetched->events.erase(range.end);
+
+    deleteReleasedPrefetchedEvents();
+    m_sentPrefetchedEvents.push_back(prefetched);
+    midiData.stream.prefetchStream.send(std::move(prefetched));
+}
+
+void MasterNotationMidiData::deleteReleasedPrefetchedEvents() const
+{
+    //! NOTE Nothing else can take the events once they are only held here
+    m_sentPrefetchedEvents.erase(std::remove_if(m_sentPrefetchedEvents.begin(), m_sentPrefetchedEvents.end(),
+                                                [](const PrefetchedEventsPtr& events) {
+        return events.use_count() == 1;
+    }), m_sentPrefetchedEvents.end());
+}
+
+void MasterNotationMidiData::invalidatePrefetchedEvents()
+{
+    if (!m_prefetchedRanges.empty()) {
+        m_prefetchedRanges.clear();
+
+        for (auto& pair : m_midiDataMap) {
+            pair.second.stream.prefetchStream.send(nullptr);
+        }
+    }
+
+    if (!m_requestedPrefetchTicks.empty()) {
+        schedulePrefetch();
+    }
+}
+
 Ms::Score* MasterNotationMidiData::score() const
 {
     return m_getScore->score();
@@ -261,9 +446,26 @@ MidiStream MasterNotationMidiData::buildMidiStream(const Ms::Part* part) const
         });
     }
 
+    stream.prefetchReleased.onNotify(this, [this]() {
+        deleteReleasedPrefetchedEvents();
+    });
+
     return stream;
 }
 
+std::vector<channel_t> MasterNotationMidiData::partMidiChannels(const Ms::Part* part) const
+{
+    std::vector<channel_t> result;
+
+    for (auto it = part->instruments()->cbegin(); it != part->instruments()->cend(); ++it) {
+        for (const Ms::Channel* channel : it->second->channel()) {
+            result.push_back(channel->channel());
+        }
+    }
+
+    return result;
+}
+
 TempoMap MasterNotationMidiData::makeTempoMap() const
 {
     midi::TempoMap tempos;
@@ -402,6 +604,7 @@ Ms::EventMap MasterNotationMidiData::renderMsEvents(const tick_t fromTick, const
     Ms::MidiRenderer::Context ctx;
     ctx.metronome = configuration()->isMetronomeEnabled();
     ctx.renderHarmony = true;
+    ctx.renderStavesConcurrently = true;
 
     for (const auto& mschunk : mschunks) {
         m_midiRenderImpl->renderChunk(mschunk, &msevents, ctx);
@@ -414,23 +617,19 @@ Events MasterNotationMidiData::convertMsEvents(Ms::EventMap&& eventMap) const
 {
     Events result;
 
-    std::set<tick_t> tickKeySet;
-    for (const auto& pair : eventMap) {
-        tickKeySet.insert(pair.first);
-    }
+    static const std::set<Ms::EventType> SKIP_EVENTS
+        = { Ms::EventType::ME_INVALID, Ms::EventType::ME_EOT, Ms::EventType::ME_TICK1, Ms::EventType::ME_TICK2 };
 
-    for (const tick_t tick : tickKeySet) {
+    //! NOTE The events are sorted by tick, so they are grouped in a single pass
+    auto it = eventMap.cbegin();
+    while (it != eventMap.cend()) {
+        const int tick = it->first;
         std::vector<midi::Event> events;
 
-        auto it = eventMap.equal_range(tick);
-
-        for (auto itr = it.first; itr != it.second; ++itr) {
-            const Ms::NPlayEvent ev = itr->second;
+        for (; it != eventMap.cend() && it->first == tick; ++it) {
+            const Ms::NPlayEvent& ev = it->second;
 
             Ms::EventType etype = static_cast<Ms::EventType>(ev.type());
-            static const std::set<Ms::EventType> SKIP_EVENTS
-                = { Ms::EventType::ME_INVALID, Ms::EventType::ME_EOT, Ms::EventType::ME_TICK1, Ms::EventType::ME_TICK2 };
-
             if (SKIP_EVENTS.find(etype) != SKIP_EVENTS.end()) {
                 continue;
             }
@@ -440,7 +639,7 @@ Events MasterNotationMidiData::convertMsEvents(Ms::EventMap&& eventMap) const
             events.push_back(std::move(e));
         }
 
-        result.insert({ tick, std::move(events) });
+        result.insert({ static_cast<tick_t>(tick), std::move(events) });
     }
 
     return result;
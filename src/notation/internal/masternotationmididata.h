@@ -54,6 +54,9 @@ public:
     midi::Events retrieveEventsForElement(const EngravingItem* element, const midi::channel_t midiChannel) const override;
     std::vector<midi::Event> retrieveSetupEvents(const std::list<InstrumentChannel*> instrChannel) const override;
 
+    void prefetchEvents(const std::vector<midi::tick_t>& ticks) override;
+    void resendPrefetchedEvents(const ID& partId) override;
+
 private:
     struct TicksRange {
         midi::tick_t start = 0;
@@ -94,6 +97,14 @@ private:
     midi::MidiMapping buildMidiMapping(const Ms::Part* part) const;
     midi::MidiStream buildMidiStream(const Ms::Part* part) const;
     midi::TempoMap makeTempoMap() const;
+    std::vector<midi::channel_t> partMidiChannels(const Ms::Part* part) const;
+
+    std::vector<midi::tick_t> prefetchTicks() const;
+    void schedulePrefetch();
+    void prefetchNextRange();
+    void sendPrefetchedEvents(const Ms::Part* part, midi::MidiData& midiData, const TicksRange& range) const;
+    void deleteReleasedPrefetchedEvents() const;
+    void invalidatePrefetchedEvents();
 
     // play element
     Ret playNoteMidiData(const Ms::Note* note) const;
@@ -117,7 +128,15 @@ private:
 
     std::map<ID /*partId*/, midi::MidiData> m_midiDataMap;
 
+    std::vector<midi::tick_t> m_requestedPrefetchTicks;
+    std::vector<TicksRange> m_prefetchedRanges;
+    bool m_isPrefetchScheduled = false;
+
+    //! NOTE The prefetched events sent to the audio thread, deleted here once it has released them
+    mutable std::vector<midi::PrefetchedEventsPtr> m_sentPrefetchedEvents;
+
     std::unique_ptr<Ms::MidiRenderer> m_midiRenderImpl = nullptr;
+    uint64_t m_contentChangesCount = 0;
     IGetScore* m_getScore = nullptr;
     INotationPartsPtr m_parts = nullptr;
 };
@@ -98,6 +98,7 @@ Notation::Notation(Ms::Score* score)
         for (Ms::Score* score : m_score->scoreList()) {
             score->doLayout();
         }
+        notifyAboutNotationChanged();
     });
 
     setScore(score);
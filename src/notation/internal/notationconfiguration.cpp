@@ -78,6 +78,7 @@ static const Settings::Key IS_LIMIT_CANVAS_SCROLL_AREA_KEY(module_name, "ui/canv
 static const Settings::Key COLOR_NOTES_OUTSIDE_OF_USABLE_PITCH_RANGE(module_name, "score/note/warnPitchRange");
 static const Settings::Key REALTIME_DELAY(module_name, "io/midi/realtimeDelay");
 static const Settings::Key NOTE_DEFAULT_PLAY_DURATION(module_name, "score/note/defaultPlayDuration");
+static const Settings::Key UNDO_HISTORY_MEMORY_LIMIT(module_name, "application/undoHistoryMemoryLimit");
 
 static const Settings::Key FIRST_INSTRUMENT_LIST_KEY(module_name, "application/paths/instrumentList1");
 static const Settings::Key SECOND_INSTRUMENT_LIST_KEY(module_name, "application/paths/instrumentList2");
@@ -91,6 +92,11 @@ static const Settings::Key VERTICAL_GRID_SIZE_KEY(module_name,  "ui/application/
 
 static constexpr int DEFAULT_GRID_SIZE_SPATIUM = 2;
 
+static size_t megabytesToBytes(int megabytes)
+{
+    return static_cast<size_t>(std::max(megabytes, 0)) * 1024 * 1024;
+}
+
 void NotationConfiguration::init()
 {
     settings()->setDefaultValue(BACKGROUND_USE_COLOR, Val(true));
@@ -179,6 +185,9 @@ void NotationConfiguration::init()
     settings()->setDefaultValue(REALTIME_DELAY, Val(750));
     settings()->setDefaultValue(NOTE_DEFAULT_PLAY_DURATION, Val(300));
 
+    //! NOTE In megabytes, 0 - unlimited
+    settings()->setDefaultValue(UNDO_HISTORY_MEMORY_LIMIT, Val(512));
+
     settings()->setDefaultValue(FIRST_INSTRUMENT_LIST_KEY,
                                 Val(globalConfiguration()->appDataPath().toStdString() + "instruments/instruments.xml"));
     settings()->valueChanged(FIRST_INSTRUMENT_LIST_KEY).onReceive(nullptr, [this](const Val&) {
@@ -206,6 +215,7 @@ void NotationConfiguration::init()
 
     Ms::MScore::warnPitchRange = colorNotesOusideOfUsablePitchRange();
     Ms::MScore::defaultPlayDuration = notePlayDurationMilliseconds();
+    Ms::MScore::undoMemoryBudget = megabytesToBytes(undoHistoryMemoryLimitMegabytes());
 
     Ms::MScore::setHRaster(DEFAULT_GRID_SIZE_SPATIUM);
     Ms::MScore::setVRaster(DEFAULT_GRID_SIZE_SPATIUM);
@@ -604,6 +614,17 @@ void NotationConfiguration::setNotePlayDurationMilliseconds(int durationMs)
     settings()->setSharedValue(NOTE_DEFAULT_PLAY_DURATION, Val(durationMs));
 }
 
+int NotationConfiguration::undoHistoryMemoryLimitMegabytes() const
+{
+    return settings()->value(UNDO_HISTORY_MEMORY_LIMIT).toInt();
+}
+
+void NotationConfiguration::setUndoHistoryMemoryLimitMegabytes(int limitMb)
+{
+    Ms::MScore::undoMemoryBudget = megabytesToBytes(limitMb);
+    settings()->setSharedValue(UNDO_HISTORY_MEMORY_LIMIT, Val(limitMb));
+}
+
 void NotationConfiguration::setTemplateModeEnalbed(bool enabled)
 {
     Ms::MScore::saveTemplateMode = enabled;
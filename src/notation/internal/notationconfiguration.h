@@ -145,6 +145,9 @@ public:
     int notePlayDurationMilliseconds() const override;
     void setNotePlayDurationMilliseconds(int durationMs) override;
 
+    int undoHistoryMemoryLimitMegabytes() const override;
+    void setUndoHistoryMemoryLimitMegabytes(int limitMb) override;
+
     void setTemplateModeEnalbed(bool enabled) override;
     void setTestModeEnabled(bool enabled) override;
 
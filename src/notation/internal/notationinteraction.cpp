@@ -28,6 +28,7 @@
 #include <QPainter>
 #include <QClipboard>
 #include <QApplication>
+#include <QScreen>
 
 #include "defer.h"
 #include "ptrutils.h"
@@ -90,6 +91,11 @@ NotationInteraction::NotationInteraction(Notation* notation, INotationUndoStackP
     m_dragData.ed = Ms::EditData(&m_scoreCallbacks);
     m_dropData.ed = Ms::EditData(&m_scoreCallbacks);
     m_scoreCallbacks.setScore(notation->score());
+
+    m_dragTimer.setSingleShot(true);
+    QObject::connect(&m_dragTimer, &QTimer::timeout, [this]() {
+        applyPendingDrag();
+    });
 }
 
 NotationInteraction::~NotationInteraction()
@@ -674,6 +680,7 @@ void NotationInteraction::DragData::reset()
     elementOffset = QPointF();
     ed = Ms::EditData(ed.view());
     dragGroups.clear();
+    pendingMove.reset();
 }
 
 void NotationInteraction::startDrag(const std::vector<EngravingItem*>& elems,
@@ -703,6 +710,12 @@ void NotationInteraction::startDrag(const std::vector<EngravingItem*>& elems,
     m_scoreCallbacks.setScore(score());
     m_scoreCallbacks.setSelectionProximity(proximity);
 
+    //! NOTE Element and grip drags alike are coalesced to the frame rate
+    static constexpr qreal DEFAULT_REFRESH_RATE = 60.0;
+    QScreen* screen = QGuiApplication::primaryScreen();
+    qreal refreshRate = screen && screen->refreshRate() > 0 ? screen->refreshRate() : DEFAULT_REFRESH_RATE;
+    m_dragTimer.setInterval(qMax(1, qRound(1000.0 / refreshRate)));
+
     if (isGripEditStarted()) {
         m_editData.element->startEditDrag(m_editData);
         return;
@@ -741,8 +754,42 @@ void NotationInteraction::endLasso()
     score()->update();
 }
 
+//! NOTE Pointer events may come much more often than the view is repainted.
+//! The first move is applied at once, the following ones at most once per frame,
+//! with the latest position only.
 void NotationInteraction::drag(const PointF& fromPos, const PointF& toPos, DragMode mode)
 {
+    if (m_dragTimer.isActive()) {
+        if (!m_dragData.pendingMove) {
+            m_dragData.pendingMove = DragData::Move { fromPos, toPos, mode };
+        } else {
+            m_dragData.pendingMove->toPos = toPos;
+            m_dragData.pendingMove->mode = mode;
+        }
+        return;
+    }
+
+    doDrag(fromPos, toPos, mode);
+    m_dragTimer.start();
+}
+
+void NotationInteraction::applyPendingDrag()
+{
+    if (!m_dragData.pendingMove) {
+        return;
+    }
+
+    DragData::Move move = m_dragData.pendingMove.value();
+    m_dragData.pendingMove.reset();
+
+    doDrag(move.fromPos, move.toPos, move.mode);
+    m_dragTimer.start();
+}
+
+void NotationInteraction::doDrag(const PointF& fromPos, const PointF& toPos, DragMode mode)
+{
+    TRACEFUNC;
+
     if (m_dragData.beginMove.isNull()) {
         m_dragData.beginMove = fromPos;
         m_dragData.ed.pos = fromPos;
@@ -801,7 +848,9 @@ void NotationInteraction::drag(const PointF& fromPos, const PointF& toPos, DragM
         }
     }
 
-    score()->update();
+    //! NOTE Only the viewed score is laid out while dragging,
+    //! the linked parts are laid out once, when the drag is applied in endDrag()
+    score()->updateDrag();
 
     if (isGripEditStarted()) {
         updateAnchorLines();
@@ -826,6 +875,9 @@ void NotationInteraction::drag(const PointF& fromPos, const PointF& toPos, DragM
 
 void NotationInteraction::doEndDrag()
 {
+    applyPendingDrag();
+    m_dragTimer.stop();
+
     if (isGripEditStarted()) {
         m_editData.element->endEditDrag(m_editData);
         m_editData.element->endEdit(m_editData);
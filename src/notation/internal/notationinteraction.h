@@ -23,8 +23,11 @@
 #define MU_NOTATION_NOTATIONINTERACTION_H
 
 #include <memory>
+#include <optional>
 #include <vector>
 
+#include <QTimer>
+
 #include "modularity/ioc.h"
 #include "async/asyncable.h"
 
@@ -250,6 +253,8 @@ private:
     void notifyAboutNotationChanged();
     void notifyAboutTextEditingStarted();
     void notifyAboutTextEditingChanged();
+    void doDrag(const PointF& fromPos, const PointF& toPos, DragMode mode);
+    void applyPendingDrag();
     void doDragLasso(const PointF& p);
     void endLasso();
     void toggleFontStyle(Ms::FontStyle);
@@ -307,12 +312,19 @@ private:
 
     struct DragData
     {
+        struct Move {
+            PointF fromPos;
+            PointF toPos;
+            DragMode mode { DragMode::BothXY };
+        };
+
         PointF beginMove;
         PointF elementOffset;
         Ms::EditData ed;
         std::vector<EngravingItem*> elements;
         std::vector<std::unique_ptr<Ms::ElementGroup> > dragGroups;
         DragMode mode { DragMode::BothXY };
+        std::optional<Move> pendingMove;
         void reset();
     };
 
@@ -333,6 +345,7 @@ private:
     async::Notification m_selectionChanged;
 
     DragData m_dragData;
+    QTimer m_dragTimer;
     async::Notification m_dragChanged;
     std::vector<LineF> m_anchorLines;
 
@@ -21,6 +21,7 @@
  */
 #include "notationplayback.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "log.h"
@@ -121,85 +122,110 @@ tick_t NotationPlayback::secToTick(float sec) const
     return score() ? score()->utime2utick(sec) : 0;
 }
 
-//! NOTE Copied from ScoreView::moveCursor(const Fraction& tick)
-RectF NotationPlayback::playbackCursorRectByTick(tick_t _tick) const
+//! NOTE Based on ScoreView::moveCursor(const Fraction& tick)
+void NotationPlayback::buildCursorGeometry() const
 {
-    if (!score()) {
-        return {};
-    }
+    TRACEFUNC;
 
-    Fraction tick = Fraction::fromTicks(_tick);
+    m_cursorGeometry.clear();
+    m_cursorSystemGeometry.clear();
+    m_cursorGeometryLayoutGeneration = score()->layoutGeneration();
 
-    Measure* measure = score()->tick2measureMM(tick);
-    if (!measure) {
-        return {};
-    }
+    double _spatium = score()->spatium();
+    qreal mag = _spatium / Ms::SPATIUM20;
+    m_cursorWidth = _spatium * 2.0 + score()->scoreFont()->width(Ms::SymId::noteheadBlack, mag);
 
-    Ms::System* system = measure->system();
-    if (!system) {
-        return {};
-    }
+    const Ms::System* lastSystem = nullptr;
 
-    qreal x = 0.0;
-    Ms::Segment* s = nullptr;
-    for (s = measure->first(Ms::SegmentType::ChordRest); s;) {
-        Fraction t1 = s->tick();
-        int x1 = s->canvasPos().x();
-        qreal x2;
-        Fraction t2;
-        Ms::Segment* ns = s->next(Ms::SegmentType::ChordRest);
-        while (ns && !ns->visible()) {
-            ns = ns->next(Ms::SegmentType::ChordRest);
+    for (Measure* measure = score()->firstMeasureMM(); measure; measure = measure->nextMeasureMM()) {
+        const Ms::System* system = measure->system();
+        if (!system || !system->page()) {
+            continue;
         }
-        if (ns) {
-            t2 = ns->tick();
-            x2 = ns->canvasPos().x();
-        } else {
-            t2 = measure->endTick();
-            // measure->width is not good enough because of courtesy keysig, timesig
-            Ms::Segment* seg = measure->findSegment(Ms::SegmentType::EndBarLine, measure->tick() + measure->ticks());
-            if (seg) {
-                x2 = seg->canvasPos().x();
-            } else {
-                x2 = measure->canvasPos().x() + measure->width();             //safety, should not happen
+
+        if (system != lastSystem) {
+            double y = system->staffYpage(0) + system->page()->pos().y();
+
+            //
+            // set cursor height for whole system
+            //
+            double y2 = 0.0;
+
+            for (int i = 0; i < score()->nstaves(); ++i) {
+                const Ms::SysStaff* ss = system->staff(i);
+                if (!ss->show() || !score()->staff(i)->show()) {
+                    continue;
+                }
+                y2 = ss->bbox().bottom();
             }
+
+            m_cursorSystemGeometry.push_back({ y - 3 * _spatium, 6 * _spatium + y2 });
+            lastSystem = system;
         }
-        if (tick >= t1 && tick < t2) {
-            Fraction dt = t2 - t1;
-            qreal dx = x2 - x1;
-            x = x1 + dx * (tick - t1).ticks() / dt.ticks();
-            break;
+
+        for (Ms::Segment* s = measure->first(Ms::SegmentType::ChordRest); s;) {
+            Fraction t1 = s->tick();
+            int x1 = s->canvasPos().x();
+            qreal x2;
+            Fraction t2;
+            Ms::Segment* ns = s->next(Ms::SegmentType::ChordRest);
+            while (ns && !ns->visible()) {
+                ns = ns->next(Ms::SegmentType::ChordRest);
+            }
+            if (ns) {
+                t2 = ns->tick();
+                x2 = ns->canvasPos().x();
+            } else {
+                t2 = measure->endTick();
+                // measure->width is not good enough because of courtesy keysig, timesig
+                Ms::Segment* seg = measure->findSegment(Ms::SegmentType::EndBarLine, measure->tick() + measure->ticks());
+                if (seg) {
+                    x2 = seg->canvasPos().x();
+                } else {
+                    x2 = measure->canvasPos().x() + measure->width();             //safety, should not happen
+                }
+            }
+
+            if (t1 < t2) {
+                m_cursorGeometry.push_back({ t1.ticks(), t2.ticks(), qreal(x1), x2, m_cursorSystemGeometry.size() - 1 });
+            }
+
+            s = ns;
         }
-        s = ns;
     }
+}
 
-    if (!s) {
+RectF NotationPlayback::playbackCursorRectByTick(tick_t tick) const
+{
+    if (!score()) {
         return {};
     }
 
-    double y = system->staffYpage(0) + system->page()->pos().y();
-    double _spatium = score()->spatium();
+    if (m_cursorGeometryLayoutGeneration != score()->layoutGeneration()) {
+        buildCursorGeometry();
+    }
 
-    qreal mag = _spatium / Ms::SPATIUM20;
-    double w  = _spatium * 2.0 + score()->scoreFont()->width(Ms::SymId::noteheadBlack, mag);
-    double h  = 6 * _spatium;
-    //
-    // set cursor height for whole system
-    //
-    double y2 = 0.0;
+    auto it = std::upper_bound(m_cursorGeometry.cbegin(), m_cursorGeometry.cend(), static_cast<int>(tick),
+                               [](int tick, const CursorGeometry& geometry) {
+        return tick < geometry.tickFrom;
+    });
 
-    for (int i = 0; i < score()->nstaves(); ++i) {
-        Ms::SysStaff* ss = system->staff(i);
-        if (!ss->show() || !score()->staff(i)->show()) {
-            continue;
-        }
-        y2 = ss->bbox().bottom();
+    if (it == m_cursorGeometry.cbegin()) {
+        return {};
     }
-    h += y2;
-    x -= _spatium;
-    y -= 3 * _spatium;
 
-    return RectF(x, y, w, h);
+    const CursorGeometry& geometry = *std::prev(it);
+    if (static_cast<int>(tick) >= geometry.tickTo) {
+        return {};
+    }
+
+    int dt = geometry.tickTo - geometry.tickFrom;
+    qreal dx = geometry.xTo - geometry.xFrom;
+    qreal x = geometry.xFrom + dx * (static_cast<int>(tick) - geometry.tickFrom) / dt;
+
+    const SystemGeometry& system = m_cursorSystemGeometry.at(geometry.systemIndex);
+
+    return RectF(x - score()->spatium(), system.y, m_cursorWidth, system.height);
 }
 
 RetVal<midi::tick_t> NotationPlayback::playPositionTickByElement(const EngravingItem* element) const
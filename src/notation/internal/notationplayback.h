@@ -23,6 +23,7 @@
 #define MU_NOTATION_NOTATIONPLAYBACK_H
 
 #include <memory>
+#include <vector>
 
 #include "modularity/ioc.h"
 #include "async/asyncable.h"
@@ -74,9 +75,34 @@ private:
 
     const Ms::TempoText* tempoText(int tick) const;
 
+    //! NOTE Geometry of the playback cursor between two neighbouring chord/rest segments,
+    //! precomputed after layout so that the cursor can be moved during playback
+    //! without walking through the score
+    struct CursorGeometry {
+        int tickFrom = 0;
+        int tickTo = 0;
+        qreal xFrom = 0.0;
+        qreal xTo = 0.0;
+        size_t systemIndex = 0;
+    };
+
+    struct SystemGeometry {
+        qreal y = 0.0;
+        qreal height = 0.0;
+    };
+
+    void buildCursorGeometry() const;
+
     IGetScore* m_getScore = nullptr;
     async::Channel<int> m_playPositionTickChanged;
     ValCh<LoopBoundaries> m_loopBoundaries;
+
+    mutable std::vector<CursorGeometry> m_cursorGeometry;
+    mutable std::vector<SystemGeometry> m_cursorSystemGeometry;
+    mutable qreal m_cursorWidth = 0.0;
+    //! NOTE The master score, or any of its parts, relayouts the viewed score without notifying this notation,
+    //! so the table is checked against the layout generation of the score instead
+    mutable int m_cursorGeometryLayoutGeneration = -1;
 };
 }
 
@@ -0,0 +1,76 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "testing/environment.h"
+
+#include <gmock/gmock.h>
+
+#include "modularity/ioc.h"
+#include "engraving/engravingmodule.h"
+#include "framework/fonts/fontsmodule.h"
+
+#include "libmscore/masterscore.h"
+#include "libmscore/instrtemplate.h"
+#include "libmscore/musescoreCore.h"
+
+#include "mocks/notationconfigurationmock.h"
+
+#include "log.h"
+
+using ::testing::NiceMock;
+using ::testing::Return;
+
+static void setupNotationConfiguration()
+{
+    using namespace mu::notation;
+
+    //! NOTE The notation is created without its module, the mock stands for the configuration all the tests long
+    auto configuration = std::make_shared<NiceMock<NotationConfigurationMock> >();
+    ::testing::Mock::AllowLeak(configuration.get());
+
+    mu::ValCh<int> zoom;
+    zoom.val = 100;
+    ON_CALL(*configuration, currentZoom()).WillByDefault(Return(zoom));
+    ON_CALL(*configuration, selectionProximity()).WillByDefault(Return(6));
+
+    mu::modularity::ioc()->registerExport<INotationConfiguration>("utests", configuration);
+}
+
+static mu::testing::SuiteEnvironment notation_se(
+{
+    new mu::fonts::FontsModule(),
+    new mu::engraving::EngravingModule()
+},
+    []() {
+    LOGI() << "notation tests suite post init";
+    Ms::MScore::testMode = true;
+    Ms::MScore::noGui = true;
+
+    new Ms::MuseScoreCore;
+    Ms::MScore* mscore = new Ms::MScore();
+    mscore->init();
+
+    Ms::loadInstrumentTemplates(":/data/instruments.xml");
+
+    setupNotationConfiguration();
+}
+    );
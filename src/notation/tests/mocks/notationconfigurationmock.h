@@ -0,0 +1,160 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#ifndef MU_NOTATION_NOTATIONCONFIGURATIONMOCK_H
+#define MU_NOTATION_NOTATIONCONFIGURATIONMOCK_H
+
+#include <gmock/gmock.h>
+
+#include "notation/inotationconfiguration.h"
+
+namespace mu::notation {
+class NotationConfigurationMock : public INotationConfiguration
+{
+public:
+    MOCK_METHOD(QColor, backgroundColor, (), (const, override));
+    MOCK_METHOD(void, setBackgroundColor, (const QColor&), (override));
+    MOCK_METHOD(void, resetCurrentBackgroundColorToDefault, (), (override));
+
+    MOCK_METHOD(io::path, backgroundWallpaperPath, (), (const, override));
+    MOCK_METHOD(void, setBackgroundWallpaperPath, (const io::path&), (override));
+
+    MOCK_METHOD(bool, backgroundUseColor, (), (const, override));
+    MOCK_METHOD(void, setBackgroundUseColor, (bool), (override));
+    MOCK_METHOD(async::Notification, backgroundChanged, (), (const, override));
+
+    MOCK_METHOD(QColor, foregroundColor, (), (const, override));
+    MOCK_METHOD(void, setForegroundColor, (const QColor&), (override));
+
+    MOCK_METHOD(io::path, foregroundWallpaperPath, (), (const, override));
+    MOCK_METHOD(void, setForegroundWallpaperPath, (const io::path&), (override));
+
+    MOCK_METHOD(bool, foregroundUseColor, (), (const, override));
+    MOCK_METHOD(void, setForegroundUseColor, (bool), (override));
+    MOCK_METHOD(async::Notification, foregroundChanged, (), (const, override));
+
+    MOCK_METHOD(io::path, wallpapersDefaultDirPath, (), (const, override));
+
+    MOCK_METHOD(QColor, borderColor, (), (const, override));
+    MOCK_METHOD(int, borderWidth, (), (const, override));
+
+    MOCK_METHOD(QColor, anchorLineColor, (), (const, override));
+
+    MOCK_METHOD(QColor, playbackCursorColor, (), (const, override));
+    MOCK_METHOD(QColor, loopMarkerColor, (), (const, override));
+    MOCK_METHOD(int, cursorOpacity, (), (const, override));
+
+    MOCK_METHOD(QColor, selectionColor, (int), (const, override));
+
+    MOCK_METHOD(int, selectionProximity, (), (const, override));
+    MOCK_METHOD(void, setSelectionProximity, (int), (override));
+
+    MOCK_METHOD(ZoomType, defaultZoomType, (), (const, override));
+    MOCK_METHOD(void, setDefaultZoomType, (ZoomType), (override));
+
+    MOCK_METHOD(int, defaultZoom, (), (const, override));
+    MOCK_METHOD(void, setDefaultZoom, (int), (override));
+
+    MOCK_METHOD(ValCh<int>, currentZoom, (), (const, override));
+    MOCK_METHOD(void, setCurrentZoom, (int), (override));
+
+    MOCK_METHOD(QList<int>, possibleZoomPercentageList, (), (const, override));
+
+    MOCK_METHOD(int, mouseZoomPrecision, (), (const, override));
+    MOCK_METHOD(void, setMouseZoomPrecision, (int), (override));
+
+    MOCK_METHOD(std::string, fontFamily, (), (const, override));
+    MOCK_METHOD(int, fontSize, (), (const, override));
+
+    MOCK_METHOD(io::path, userStylesPath, (), (const, override));
+    MOCK_METHOD(void, setUserStylesPath, (const io::path&), (override));
+    MOCK_METHOD(async::Channel<io::path>, userStylesPathChanged, (), (const, override));
+
+    MOCK_METHOD(io::path, defaultStyleFilePath, (), (const, override));
+    MOCK_METHOD(void, setDefaultStyleFilePath, (const io::path&), (override));
+
+    MOCK_METHOD(io::path, partStyleFilePath, (), (const, override));
+    MOCK_METHOD(void, setPartStyleFilePath, (const io::path&), (override));
+
+    MOCK_METHOD(bool, isMidiInputEnabled, (), (const, override));
+    MOCK_METHOD(void, setIsMidiInputEnabled, (bool), (override));
+
+    MOCK_METHOD(bool, isAutomaticallyPanEnabled, (), (const, override));
+    MOCK_METHOD(void, setIsAutomaticallyPanEnabled, (bool), (override));
+
+    MOCK_METHOD(bool, isPlayRepeatsEnabled, (), (const, override));
+    MOCK_METHOD(void, setIsPlayRepeatsEnabled, (bool), (override));
+
+    MOCK_METHOD(bool, isMetronomeEnabled, (), (const, override));
+    MOCK_METHOD(void, setIsMetronomeEnabled, (bool), (override));
+
+    MOCK_METHOD(bool, isCountInEnabled, (), (const, override));
+    MOCK_METHOD(void, setIsCountInEnabled, (bool), (override));
+
+    MOCK_METHOD(double, guiScaling, (), (const, override));
+    MOCK_METHOD(double, notationScaling, (), (const, override));
+
+    MOCK_METHOD(std::string, notationRevision, (), (const, override));
+    MOCK_METHOD(int, notationDivision, (), (const, override));
+
+    MOCK_METHOD(ValCh<framework::Orientation>, canvasOrientation, (), (const, override));
+    MOCK_METHOD(void, setCanvasOrientation, (framework::Orientation), (override));
+
+    MOCK_METHOD(bool, isLimitCanvasScrollArea, (), (const, override));
+    MOCK_METHOD(void, setIsLimitCanvasScrollArea, (bool), (override));
+    MOCK_METHOD(async::Notification, isLimitCanvasScrollAreaChanged, (), (const, override));
+
+    MOCK_METHOD(bool, colorNotesOusideOfUsablePitchRange, (), (const, override));
+    MOCK_METHOD(void, setColorNotesOusideOfUsablePitchRange, (bool), (override));
+
+    MOCK_METHOD(int, delayBetweenNotesInRealTimeModeMilliseconds, (), (const, override));
+    MOCK_METHOD(void, setDelayBetweenNotesInRealTimeModeMilliseconds, (int), (override));
+
+    MOCK_METHOD(int, notePlayDurationMilliseconds, (), (const, override));
+    MOCK_METHOD(void, setNotePlayDurationMilliseconds, (int), (override));
+
+    MOCK_METHOD(int, undoHistoryMemoryLimitMegabytes, (), (const, override));
+    MOCK_METHOD(void, setUndoHistoryMemoryLimitMegabytes, (int), (override));
+
+    MOCK_METHOD(void, setTemplateModeEnalbed, (bool), (override));
+    MOCK_METHOD(void, setTestModeEnabled, (bool), (override));
+
+    MOCK_METHOD(io::paths, instrumentListPaths, (), (const, override));
+    MOCK_METHOD(async::Notification, instrumentListPathsChanged, (), (const, override));
+
+    MOCK_METHOD(io::paths, userInstrumentListPaths, (), (const, override));
+    MOCK_METHOD(void, setUserInstrumentListPaths, (const io::paths&), (override));
+
+    MOCK_METHOD(io::paths, scoreOrderListPaths, (), (const, override));
+    MOCK_METHOD(async::Notification, scoreOrderListPathsChanged, (), (const, override));
+
+    MOCK_METHOD(io::paths, userScoreOrderListPaths, (), (const, override));
+    MOCK_METHOD(void, setUserScoreOrderListPaths, (const io::paths&), (override));
+
+    MOCK_METHOD(bool, isSnappedToGrid, (framework::Orientation), (const, override));
+    MOCK_METHOD(void, setIsSnappedToGrid, (framework::Orientation, bool), (override));
+
+    MOCK_METHOD(int, gridSizeSpatium, (framework::Orientation), (const, override));
+    MOCK_METHOD(void, setGridSize, (framework::Orientation, int), (override));
+};
+}
+
+#endif // MU_NOTATION_NOTATIONCONFIGURATIONMOCK_H
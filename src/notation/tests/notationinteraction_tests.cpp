@@ -0,0 +1,104 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+#include "async/asyncable.h"
+
+#include "notation/internal/notation.h"
+#include "notation/internal/notationinteraction.h"
+
+#include "libmscore/masterscore.h"
+#include "libmscore/slur.h"
+
+#include "utils/notationtestutils.h"
+
+using namespace mu;
+using namespace mu::notation;
+
+class NotationInteractionTests : public ::testing::Test, public async::Asyncable
+{
+};
+
+/**
+ * @brief NotationInteractionTests_gripDragIsCoalesced
+ * @details Drags the end grip of a slur several times within one frame.
+ *          Only the first move must be applied at once, the others must be merged into one pending move
+ *          which is applied no earlier than the next frame, or when the drag ends
+ */
+TEST_F(NotationInteractionTests, gripDragIsCoalesced)
+{
+    //! NOTE Any screen refreshes at 240 Hz at most
+    static constexpr qint64 MIN_FRAME_INTERVAL_MS = 4;
+
+    Ms::MasterScore* score = NotationTestUtils::readScore("data/slurs.mscx");
+    ASSERT_TRUE(score);
+
+    //! NOTE The notation owns the score
+    Notation notation(score);
+    auto interaction = std::static_pointer_cast<NotationInteraction>(notation.interaction());
+
+    Ms::Slur* slur = nullptr;
+    for (const auto& pair : score->spanner()) {
+        if (pair.second->isSlur()) {
+            slur = Ms::toSlur(pair.second);
+            break;
+        }
+    }
+    ASSERT_TRUE(slur);
+
+    EngravingItem* slurSegment = slur->frontSegment();
+    ASSERT_TRUE(slurSegment);
+
+    interaction->select({ slurSegment }, SelectType::SINGLE);
+    interaction->startEditGrip(Ms::Grip::END);
+    ASSERT_TRUE(interaction->isGripEditStarted());
+
+    int appliedMoves = 0;
+    interaction->dragChanged().onNotify(this, [&appliedMoves]() {
+        ++appliedMoves;
+    });
+
+    interaction->startDrag({ slurSegment }, PointF(), [](const EngravingItem*) { return false; });
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    PointF startPos = slurSegment->canvasPos();
+    for (int i = 1; i <= 3; ++i) {
+        interaction->drag(startPos, startPos + PointF(i, i), DragMode::BothXY);
+    }
+    EXPECT_EQ(appliedMoves, 1);
+
+    //! NOTE A drag timer without an interval would have applied the pending move here already
+    QCoreApplication::processEvents();
+    if (elapsed.elapsed() < MIN_FRAME_INTERVAL_MS) {
+        EXPECT_EQ(appliedMoves, 1);
+    }
+
+    //! NOTE The pending move is applied once, then the end of the drag is notified
+    interaction->endDrag();
+    EXPECT_EQ(appliedMoves, 3);
+}
@@ -0,0 +1,91 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "notation/internal/notationplayback.h"
+#include "notation/internal/igetscore.h"
+
+#include "libmscore/masterscore.h"
+#include "libmscore/excerpt.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/note.h"
+
+#include "utils/notationtestutils.h"
+
+using namespace mu;
+using namespace mu::notation;
+
+class NotationPlaybackTests : public ::testing::Test
+{
+public:
+    class ScoreGetter : public IGetScore
+    {
+    public:
+        explicit ScoreGetter(Ms::Score* score)
+            : m_score(score) {}
+
+        Ms::Score* score() const override { return m_score; }
+
+    private:
+        Ms::Score* m_score = nullptr;
+    };
+};
+
+/**
+ * @brief NotationPlaybackTests_excerptCursorFollowsMasterScoreEdits
+ * @details Edits the master score, which lays out the excerpt again without notifying the excerpt notation.
+ *          The playback cursor of the excerpt must be placed as if its geometry was computed from scratch
+ */
+TEST_F(NotationPlaybackTests, excerptCursorFollowsMasterScoreEdits)
+{
+    Ms::MasterScore* masterScore = NotationTestUtils::readScore("data/slurs.mscx");
+    ASSERT_TRUE(masterScore);
+
+    Ms::Excerpt* excerpt = Ms::Excerpt::createExcerptFromPart(masterScore->parts().front());
+    masterScore->initAndAddExcerpt(excerpt, true);
+
+    Ms::Score* excerptScore = excerpt->partScore();
+    excerptScore->doLayout();
+
+    ScoreGetter getExcerptScore(excerptScore);
+    NotationPlayback playback(&getExcerptScore, async::Notification());
+
+    midi::tick_t tick = masterScore->firstMeasure()->nextMeasure()->tick().ticks();
+    RectF rectBeforeEdit = playback.playbackCursorRectByTick(tick);
+    ASSERT_FALSE(rectBeforeEdit.isNull());
+
+    //! NOTE Shorter notes in the first measure make it wider, the second measure moves to the right
+    masterScore->startCmd();
+    Ms::Segment* segment = masterScore->firstMeasure()->first(Ms::SegmentType::ChordRest);
+    masterScore->setNoteRest(segment, 0, Ms::NoteVal(72), Fraction(1, 16));
+    masterScore->endCmd();
+
+    NotationPlayback freshPlayback(&getExcerptScore, async::Notification());
+    RectF expectedRect = freshPlayback.playbackCursorRectByTick(tick);
+
+    EXPECT_NE(expectedRect, rectBeforeEdit);
+    EXPECT_EQ(playback.playbackCursorRectByTick(tick), expectedRect);
+
+    delete masterScore;
+}
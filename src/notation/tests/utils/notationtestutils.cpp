@@ -0,0 +1,50 @@
+/*
+ * SPDX-License-Identifier: GPL-3.0-only
+ * MuseScore-CLA-applies
+ *
+ * MuseScore
+ * Music Composition & Notation
+ *
+ * Copyright (C) 2021 MuseScore BVBA and others
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "notationtestutils.h"
+
+#include "engraving/compat/scoreaccess.h"
+#include "engraving/compat/mscxcompat.h"
+#include "libmscore/masterscore.h"
+
+#include "log.h"
+
+using namespace mu::notation;
+using namespace mu::engraving;
+
+Ms::MasterScore* NotationTestUtils::readScore(const QString& fileName)
+{
+    QString path = QString(notation_test_DATA_ROOT) + "/" + fileName;
+    Ms::MasterScore* score = compat::ScoreAccess::createMasterScoreWithBaseStyle();
+
+    Ms::Score::FileError rv = compat::loadMsczOrMscx(score, path, false);
+    if (rv != Ms::Score::FileError::FILE_NO_ERROR) {
+        LOGE() << "can't load score, path: " << path;
+        delete score;
+        return nullptr;
+    }
+
+    for (Ms::Score* s : score->scoreList()) {
+        s->doLayout();
+    }
+
+    return score;
+}
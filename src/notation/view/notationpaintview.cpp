@@ -371,6 +371,7 @@ void NotationPaintView::paint(QPainter* qp)
 
     mu::draw::Painter mup(qp, objectName().toStdString());
     mu::draw::Painter* painter = &mup;
+    painter->setSymbolsCacheEnabled(true);
 
     RectF rect(0.0, 0.0, width(), height());
     paintBackground(rect, painter);
@@ -128,6 +128,10 @@ void PlaybackController::seek(const midi::tick_t tick)
 
     msecs_t milliseconds = secondsToMilliseconds(notationPlayback()->tickToSec(tick));
     playback()->player()->seek(m_currentSequenceId, std::move(milliseconds));
+
+    if (!m_isPlaying) {
+        prefetchEvents(tick);
+    }
 }
 
 void PlaybackController::seek(const audio::msecs_t msecs)
@@ -299,6 +303,8 @@ void PlaybackController::pause()
 
     m_isPlaying = false;
     m_isPlayingChanged.notify();
+
+    prefetchEvents(m_currentTick);
 }
 
 void PlaybackController::stop()
@@ -416,9 +422,27 @@ void PlaybackController::setLoop(const LoopBoundaries& boundaries)
     playback()->player()->setLoop(m_currentSequenceId, fromMilliseconds, toMilliseconds);
     showLoop();
 
+    prefetchEvents(m_currentTick);
+
     notifyActionCheckedChanged(LOOP_CODE);
 }
 
+void PlaybackController::prefetchEvents(const tick_t playbackTick)
+{
+    if (!masterNotationMidiData() || !notationPlayback()) {
+        return;
+    }
+
+    std::vector<tick_t> ticks { playbackTick };
+
+    LoopBoundaries loop = notationPlayback()->loopBoundaries().val;
+    if (loop.visible) {
+        ticks.push_back(loop.loopInTick);
+    }
+
+    masterNotationMidiData()->prefetchEvents(ticks);
+}
+
 void PlaybackController::showLoop()
 {
     if (notationPlayback()) {
@@ -495,6 +519,9 @@ void PlaybackController::addTrack(const ID& partId, const std::string& title)
 
         m_trackIdMap.insert({ partId, trackId });
 
+        //! NOTE The new track has missed the events prefetched before
+        masterNotationMidiData()->resendPrefetchedEvents(partId);
+
         audioSettings()->setTrackInputParams(partId, appliedParams.in);
         audioSettings()->setTrackOutputParams(partId, appliedParams.out);
     })
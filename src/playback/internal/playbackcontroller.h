@@ -114,6 +114,7 @@ private:
     void addLoopBoundaryToTick(notation::LoopBoundaryType type, int tick);
 
     void setLoop(const notation::LoopBoundaries& boundaries);
+    void prefetchEvents(const midi::tick_t playbackTick);
 
     void showLoop();
     void hideLoop();
@@ -43,6 +43,11 @@ unsigned int AudioConfigurationStub::driverBufferSize() const
     return 0;
 }
 
+io::path AudioConfigurationStub::renderFilePath() const
+{
+    return io::path();
+}
+
 bool AudioConfigurationStub::isShowControlsInMixer() const
 {
     return false;
@@ -37,6 +37,8 @@ public:
     int audioChannelsCount() const override;
     unsigned int driverBufferSize() const override;  // samples
 
+    io::path renderFilePath() const override;
+
     bool isShowControlsInMixer() const override;
     void setIsShowControlsInMixer(bool show) override;
 
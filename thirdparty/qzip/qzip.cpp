@@ -546,6 +546,8 @@ public:
     MQZipReader::Status status;
 };
 
+class MQZipEntryDevice;
+
 class MQZipWriterPrivate : public MQZipPrivate
 {
 public:
@@ -557,15 +559,50 @@ public:
     {
     }
 
+    ~MQZipWriterPrivate();
+
     MQZipWriter::Status status;
     QFile::Permissions permissions;
     MQZipWriter::CompressionPolicy compressionPolicy;
+    MQZipEntryDevice* entryDevice = nullptr;
 
     enum EntryType {
         Directory, File, Symlink
     };
 
+    void initHeader(FileHeader& header, EntryType type, const QString& fileName);
     void addEntry(EntryType type, const QString& fileName, const QByteArray& contents);
+    void closeEntryDevice();
+};
+
+/*
+    Write-only device compressing everything written to it straight into
+    a new file entry of the archive. The local header is written first with
+    empty sizes and patched once the entry is closed, so the archive device
+    must be seekable (MQZipWriter requires that anyway).
+*/
+class MQZipEntryDevice : public QIODevice
+{
+public:
+    explicit MQZipEntryDevice(MQZipWriterPrivate* d)
+        : m_d(d) {}
+    ~MQZipEntryDevice() override { close(); }
+
+    bool begin(const QString& fileName);
+    void close() override;
+
+protected:
+    qint64 readData(char*, qint64) override { return -1; }
+    qint64 writeData(const char* data, qint64 len) override;
+
+private:
+    bool deflateData(const char* data, qint64 len, int flush);
+
+    MQZipWriterPrivate* m_d = nullptr;
+    FileHeader m_header;
+    z_stream m_stream;
+    uLong m_crc = 0;
+    qint64 m_localHeaderPos = 0;
 };
 
 LocalFileHeader CentralFileHeader::toLocalHeader() const
@@ -675,6 +712,53 @@ void MQZipReaderPrivate::scanFiles()
     }
 }
 
+void MQZipWriterPrivate::initHeader(FileHeader& header, EntryType type, const QString& fileName)
+{
+    memset(&header.h, 0, sizeof(CentralFileHeader));
+    writeUInt(header.h.signature, 0x02014b50);
+
+    writeUShort(header.h.version_needed, ZIP_VERSION);
+    writeMSDosDate(header.h.last_mod_file, QDateTime::currentDateTime());
+
+    // if bit 11 is set, the filename and comment fields must be encoded using UTF-8
+    ushort general_purpose_bits = Utf8Names; // always use utf-8
+    writeUShort(header.h.general_purpose_bits, general_purpose_bits);
+
+    const bool inUtf8 = (general_purpose_bits & Utf8Names) != 0;
+    header.file_name = inUtf8 ? fileName.toUtf8() : fileName.toLocal8Bit();
+    if (header.file_name.size() > 0xffff) {
+        qWarning("QZip: Filename is too long, chopping it to 65535 bytes");
+        header.file_name = header.file_name.left(0xffff); // ### don't break the utf-8 sequence, if any
+    }
+    if (header.file_comment.size() + header.file_name.size() > 0xffff) {
+        qWarning("QZip: File comment is too long, chopping it to 65535 bytes");
+        header.file_comment.truncate(0xffff - header.file_name.size()); // ### don't break the utf-8 sequence, if any
+    }
+    writeUShort(header.h.file_name_length, header.file_name.length());
+    //h.extra_field_length[2];
+
+    writeUShort(header.h.version_made, HostUnix << 8);
+    //uchar internal_file_attributes[2];
+    //uchar external_file_attributes[4];
+    quint32 mode = permissionsToMode(permissions);
+    switch (type) {
+    case Symlink:
+        mode |= UnixFileAttributes::SymLink;
+        break;
+    case Directory:
+        mode |= UnixFileAttributes::Dir;
+        break;
+    case File:
+        mode |= UnixFileAttributes::File;
+        break;
+    default:
+        Q_UNREACHABLE();
+        break;
+    }
+    writeUInt(header.h.external_file_attributes, mode << 16);
+    writeUInt(header.h.offset_local_header, start_of_directory);
+}
+
 void MQZipWriterPrivate::addEntry(EntryType type, const QString& fileName,
                                   const QByteArray& contents /*, QFile::Permissions permissions, QZip::Method m*/)
 {
@@ -687,6 +771,8 @@ void MQZipWriterPrivate::addEntry(EntryType type, const QString& fileName,
              << (type == 2 ? QByteArray(" -> " + contents).constData() : "");
 #endif
 
+    closeEntryDevice();
+
     if (!(device->isOpen() || device->open(QIODevice::WriteOnly))) {
         status = MQZipWriter::FileOpenError;
         return;
@@ -704,12 +790,9 @@ void MQZipWriterPrivate::addEntry(EntryType type, const QString& fileName,
     }
 
     FileHeader header;
-    memset(&header.h, 0, sizeof(CentralFileHeader));
-    writeUInt(header.h.signature, 0x02014b50);
+    initHeader(header, type, fileName);
 
-    writeUShort(header.h.version_needed, ZIP_VERSION);
     writeUInt(header.h.uncompressed_size, contents.length());
-    writeMSDosDate(header.h.last_mod_file, QDateTime::currentDateTime());
     QByteArray data = contents;
     if (compression == MQZipWriter::AlwaysCompress) {
         writeUShort(header.h.compression_method, CompressionMethodDeflated);
@@ -742,44 +825,6 @@ void MQZipWriterPrivate::addEntry(EntryType type, const QString& fileName,
     crc_32 = ::crc32(crc_32, (const uchar*)contents.constData(), contents.length());
     writeUInt(header.h.crc_32, crc_32);
 
-    // if bit 11 is set, the filename and comment fields must be encoded using UTF-8
-    ushort general_purpose_bits = Utf8Names; // always use utf-8
-    writeUShort(header.h.general_purpose_bits, general_purpose_bits);
-
-    const bool inUtf8 = (general_purpose_bits & Utf8Names) != 0;
-    header.file_name = inUtf8 ? fileName.toUtf8() : fileName.toLocal8Bit();
-    if (header.file_name.size() > 0xffff) {
-        qWarning("QZip: Filename is too long, chopping it to 65535 bytes");
-        header.file_name = header.file_name.left(0xffff); // ### don't break the utf-8 sequence, if any
-    }
-    if (header.file_comment.size() + header.file_name.size() > 0xffff) {
-        qWarning("QZip: File comment is too long, chopping it to 65535 bytes");
-        header.file_comment.truncate(0xffff - header.file_name.size()); // ### don't break the utf-8 sequence, if any
-    }
-    writeUShort(header.h.file_name_length, header.file_name.length());
-    //h.extra_field_length[2];
-
-    writeUShort(header.h.version_made, HostUnix << 8);
-    //uchar internal_file_attributes[2];
-    //uchar external_file_attributes[4];
-    quint32 mode = permissionsToMode(permissions);
-    switch (type) {
-    case Symlink:
-        mode |= UnixFileAttributes::SymLink;
-        break;
-    case Directory:
-        mode |= UnixFileAttributes::Dir;
-        break;
-    case File:
-        mode |= UnixFileAttributes::File;
-        break;
-    default:
-        Q_UNREACHABLE();
-        break;
-    }
-    writeUInt(header.h.external_file_attributes, mode << 16);
-    writeUInt(header.h.offset_local_header, start_of_directory);
-
     fileHeaders.append(header);
 
     LocalFileHeader h = header.h.toLocalHeader();
@@ -790,6 +835,102 @@ void MQZipWriterPrivate::addEntry(EntryType type, const QString& fileName,
     dirtyFileTree = true;
 }
 
+MQZipWriterPrivate::~MQZipWriterPrivate()
+{
+    delete entryDevice;
+}
+
+void MQZipWriterPrivate::closeEntryDevice()
+{
+    if (entryDevice) {
+        entryDevice->close();
+    }
+}
+
+bool MQZipEntryDevice::begin(const QString& fileName)
+{
+    if (!(m_d->device->isOpen() || m_d->device->open(QIODevice::WriteOnly))) {
+        m_d->status = MQZipWriter::FileOpenError;
+        return false;
+    }
+    m_d->device->seek(m_d->start_of_directory);
+
+    m_stream.zalloc = (alloc_func)0;
+    m_stream.zfree = (free_func)0;
+    m_stream.opaque = (voidpf)0;
+    if (deflateInit2(&m_stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        m_d->status = MQZipWriter::FileError;
+        return false;
+    }
+
+    m_d->initHeader(m_header, MQZipWriterPrivate::File, fileName);
+    writeUShort(m_header.h.compression_method, CompressionMethodDeflated);
+
+    // sizes and crc are not known yet, see close()
+    m_localHeaderPos = m_d->device->pos();
+    LocalFileHeader h = m_header.h.toLocalHeader();
+    m_d->device->write((const char*)&h, sizeof(LocalFileHeader));
+    m_d->device->write(m_header.file_name);
+
+    m_crc = ::crc32(0, 0, 0);
+    return QIODevice::open(QIODevice::WriteOnly);
+}
+
+bool MQZipEntryDevice::deflateData(const char* data, qint64 len, int flush)
+{
+    char out[16384];
+    m_stream.next_in = (Bytef*)data;
+    m_stream.avail_in = (uInt)len;
+    do {
+        m_stream.next_out = (Bytef*)out;
+        m_stream.avail_out = sizeof(out);
+        if (::deflate(&m_stream, flush) == Z_STREAM_ERROR) {
+            return false;
+        }
+        const qint64 have = qint64(sizeof(out) - m_stream.avail_out);
+        if (have > 0 && m_d->device->write(out, have) != have) {
+            return false;
+        }
+    } while (m_stream.avail_out == 0);
+    return true;
+}
+
+qint64 MQZipEntryDevice::writeData(const char* data, qint64 len)
+{
+    m_crc = ::crc32(m_crc, (const Bytef*)data, (uInt)len);
+    if (!deflateData(data, len, Z_NO_FLUSH)) {
+        m_d->status = MQZipWriter::FileWriteError;
+        return -1;
+    }
+    return len;
+}
+
+void MQZipEntryDevice::close()
+{
+    if (!isOpen()) {
+        return;
+    }
+    QIODevice::close();
+
+    if (!deflateData(nullptr, 0, Z_FINISH)) {
+        m_d->status = MQZipWriter::FileWriteError;
+    }
+    writeUInt(m_header.h.crc_32, uint(m_crc));
+    writeUInt(m_header.h.compressed_size, uint(m_stream.total_out));
+    writeUInt(m_header.h.uncompressed_size, uint(m_stream.total_in));
+    deflateEnd(&m_stream);
+
+    const qint64 end = m_d->device->pos();
+    LocalFileHeader h = m_header.h.toLocalHeader();
+    m_d->device->seek(m_localHeaderPos);
+    m_d->device->write((const char*)&h, sizeof(LocalFileHeader));
+    m_d->device->seek(end);
+
+    m_d->fileHeaders.append(m_header);
+    m_d->start_of_directory = end;
+    m_d->dirtyFileTree = true;
+}
+
 //////////////////////////////  Reader
 
 /*!
@@ -1346,6 +1487,25 @@ void MQZipWriter::addFile(const QString& fileName, QIODevice* device)
     }
 }
 
+/*!
+    Add a file to the archive and return a device the contents can be
+    written to. The data is compressed into the archive as it is written,
+    without keeping the whole file in memory. The entry is finished when the
+    device is closed, or when another entry is added or the archive is closed.
+    The device is owned by the writer. Returns nullptr on error.
+*/
+QIODevice* MQZipWriter::openFile(const QString& fileName)
+{
+    d->closeEntryDevice();
+    delete d->entryDevice;
+    d->entryDevice = new MQZipEntryDevice(d);
+    if (!d->entryDevice->begin(QDir::fromNativeSeparators(fileName))) {
+        delete d->entryDevice;
+        d->entryDevice = nullptr;
+    }
+    return d->entryDevice;
+}
+
 /*!
     Create a new directory in the archive with the specified \a dirName and
     the \a permissions;
@@ -1380,6 +1540,8 @@ void MQZipWriter::close()
         return;
     }
 
+    d->closeEntryDevice();
+
     //qDebug("QZip::close writing directory, %d entries", d->fileHeaders.size());
     d->device->seek(d->start_of_directory);
     // write new directory
@@ -101,6 +101,8 @@ public:
 
     void addFile(const QString &fileName, QIODevice *device);
 
+    QIODevice* openFile(const QString &fileName);
+
     void addDirectory(const QString &dirName);
 
     void addSymLink(const QString &fileName, const QString &destination);